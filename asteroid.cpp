@@ -31,21 +31,18 @@ void Asteroid::Spawn(Game *game)
 
 	Entity::Spawn(game);
 
-	// Create an empty parent object for the asteroid which we can rotate around freely.
+	// Create the asteroid object and set an asteroid model to it.
 	SetSceneObject(game->SpawnSceneObject());
 
-	// Create the asteroid object.
-	object_t *asteroidObject = game->SpawnSceneObject(GetSceneObject());
-
-	// Load and set an asteroid model.
 	model_t *asteroidModel = res_get_model("rock01");
-	obj_set_model(asteroidObject, asteroidModel);
+	obj_set_model(GetSceneObject(), asteroidModel);
 
-	// Randomize the asteroid's initial position.
+	// Randomize the asteroid's initial orientation. The random rotation is combined with the
+	// rotation of the movement so the asteroid needs no parent object to rotate around.
 	quat_t randomRotation = quat_from_euler_deg(
 		Utils::Random(0.0f, 360.0f), Utils::Random(0.0f, 360.0f), Utils::Random(0.0f, 360.0f));
 
-	obj_set_local_rotation(asteroidObject, randomRotation);
+	SetModelRotation(randomRotation);
 }
 
 void Asteroid::SetSize(AsteroidSize size)
@@ -105,11 +102,11 @@ void Asteroid::Destroy(Game *game)
 	}
 
 	// Spawn a cool asteroid breaking effect.
-	game->GetScene()->SpawnEffect("asteroid-explosion", GetPosition());
+	game->GetScene()->SpawnEffect("asteroid-explosion", GetPosition(), GetBoundingRadius());
 
 	game->GetScene()->SpawnLightFlash(GetPosition(), col(255, 175, 50), 10, 0.25f);
 
-	audio_play_sound(res_get_sound("SmallExplosion"), 0);
+	Utils::PlaySound("SmallExplosion", 0);
 
 	// Do final cleanup.
 	game->GetScene()->GetAsteroidHandler()->RemoveReference(this);
@@ -126,7 +123,10 @@ void Asteroid::OnCollideWith(const Game *game, Entity *other)
 		// Calculate damage to the asteroid.
 		DecreaseHealth();
 	}
-	else if (other->GetType() == ENTITY_ASTEROID) {
-		game->GetScene()->SpawnEffect("asteroid-dust", GetPosition());
+	else if (other->GetType() == ENTITY_ASTEROID &&
+		!WasCollidingWith(other)) {
+
+		// Only spawn dust when the asteroids first touch, not on every frame they overlap.
+		game->GetScene()->SpawnEffect("asteroid-dust", GetPosition(), GetBoundingRadius());
 	}
 }
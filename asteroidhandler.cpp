@@ -1,6 +1,7 @@
 #include "asteroidhandler.h"
 #include "game.h"
 #include "utils.h"
+#include "probes.h"
 #include <mylly/math/math.h>
 
 // -------------------------------------------------------------------------------------------------
@@ -102,8 +103,31 @@ bool AsteroidHandler::IsClearOfAsteroids(const Vec2 &position, float radius)
 	return true;
 }
 
+Asteroid *AsteroidHandler::GetNearestAsteroid(const Vec2 &position) const
+{
+	Asteroid *asteroid, *nearest = nullptr;
+	float nearestDistance = 0;
+
+	arr_foreach(m_asteroids, asteroid) {
+
+		// Measure the distance to the surface of the asteroid rather than its center.
+		Vec2 direction = asteroid->GetPosition() - position;
+		float distance = direction.Normalize() - asteroid->GetBoundingRadius();
+
+		if (nearest == nullptr || distance < nearestDistance) {
+
+			nearest = asteroid;
+			nearestDistance = distance;
+		}
+	}
+
+	return nearest;
+}
+
 void AsteroidHandler::OnAsteroidDestroyed(Asteroid *destroyed, Game *game)
 {
+	GAME_PROBE2(asteroid_destroyed, (int)destroyed->GetSize(), m_asteroids.count);
+
 	// Increment player score.
 	switch (destroyed->GetSize()) {
 
@@ -25,6 +25,7 @@ public:
 	void DestroyAllAsteroids(Game *game);
 
 	bool IsClearOfAsteroids(const Vec2 &position, float radius);
+	Asteroid *GetNearestAsteroid(const Vec2 &position) const;
 
 private:
 	void OnAsteroidDestroyed(Asteroid *destroyed, Game *game);
@@ -0,0 +1,185 @@
+#include "autopilot.h"
+#include "game.h"
+#include "gamescene.h"
+#include "asteroidhandler.h"
+#include "projectile.h"
+#include "ship.h"
+#include "ufo.h"
+#include <mylly/core/time.h>
+#include <mylly/math/math.h>
+
+// -------------------------------------------------------------------------------------------------
+
+Autopilot::Autopilot(void)
+{
+}
+
+Autopilot::~Autopilot(void)
+{
+}
+
+void Autopilot::Update(Game *game)
+{
+	m_steering = 0;
+	m_acceleration = 0;
+	m_isFiring = false;
+
+	Scene *scene = game->GetScene();
+
+	if (scene == nullptr ||
+		game->IsLoadingLevel() ||
+		game->IsPaused()) {
+
+		ProcessConfirm(false);
+		return;
+	}
+
+	// Start a new game from the main menu.
+	if (scene->GetType() == SCENE_MENU) {
+
+		ProcessConfirm(true);
+
+		if (m_isConfirming) {
+
+			game->StartNewGame();
+			ProcessConfirm(false);
+		}
+
+		return;
+	}
+
+	Ship *ship = ((GameScene *)scene)->GetPlayerShip();
+
+	// Confirm level transitions and respawns. The game checks whether it's actually waiting for
+	// confirmation, so it doesn't matter if the ship just hasn't been spawned yet.
+	ProcessConfirm(game->IsLevelCompleted() || ship == nullptr);
+
+	if (ship != nullptr) {
+		FlyShip(game, ship);
+	}
+}
+
+void Autopilot::FlyShip(Game *game, Ship *ship)
+{
+	Vec2 position = ship->GetPosition();
+	float heading = ship->GetHeading();
+
+	// Evade asteroids which are too close to the ship by flying directly away from them.
+	Asteroid *closest = game->GetScene()->GetAsteroidHandler()->GetNearestAsteroid(position);
+
+	if (closest != nullptr) {
+
+		Vec2 away = position - closest->GetPosition();
+		float distance = away.Normalize();
+
+		if (distance < closest->GetBoundingRadius() + Ship::RADIUS + EVADE_DISTANCE) {
+
+			m_steering = GetSteering(GetHeadingError(heading, away));
+			m_acceleration = 1;
+			m_isFiring = true;
+			return;
+		}
+	}
+
+	// Attack the nearest target.
+	Entity *target = FindNearestTarget(game, position);
+
+	if (target == nullptr) {
+		return;
+	}
+
+	Vec2 direction = CalculateAimPoint(ship, target) - position;
+	float distance = direction.Normalize();
+
+	float headingError = GetHeadingError(heading, direction);
+	m_steering = GetSteering(headingError);
+
+	// Fire when the ship is facing the target and the target is within range.
+	m_isFiring = (fabsf(headingError) < FIRE_ANGLE &&
+	              distance < FIRE_RANGE + target->GetBoundingRadius());
+
+	// Close in on targets which are far away, but don't let the ship gain too much speed.
+	float speed = ship->GetVelocity().Normalize();
+
+	if (distance > APPROACH_DISTANCE &&
+		speed < CRUISE_SPEED &&
+		fabsf(headingError) < 45.0f) {
+
+		m_acceleration = 1;
+	}
+}
+
+void Autopilot::ProcessConfirm(bool needsConfirm)
+{
+	if (!needsConfirm) {
+
+		m_confirmTime = 0;
+		m_isConfirming = false;
+		return;
+	}
+
+	// Wait for a moment like a human player would before pressing the confirm button.
+	float time = get_time().real_time;
+
+	if (m_confirmTime == 0) {
+		m_confirmTime = time + CONFIRM_DELAY;
+	}
+
+	m_isConfirming = (time >= m_confirmTime);
+}
+
+Entity *Autopilot::FindNearestTarget(Game *game, const Vec2 &position) const
+{
+	Entity *target = game->GetScene()->GetAsteroidHandler()->GetNearestAsteroid(position);
+	Ufo *ufo = ((GameScene *)game->GetScene())->GetUfo();
+
+	if (ufo == nullptr) {
+		return target;
+	}
+
+	if (target == nullptr) {
+		return ufo;
+	}
+
+	// Prefer whichever is closer to the ship.
+	Vec2 toTarget = target->GetPosition() - position;
+	Vec2 toUfo = ufo->GetPosition() - position;
+
+	return (toUfo.Dot(toUfo) < toTarget.Dot(toTarget) ? ufo : target);
+}
+
+Vec2 Autopilot::CalculateAimPoint(const Ship *ship, const Entity *target) const
+{
+	// Lead the target by the time it takes for a projectile to reach its current position.
+	// Projectiles inherit the velocity of the ship, so use the relative velocity of the target.
+	Vec2 toTarget = target->GetPosition() - ship->GetPosition();
+	float distance = toTarget.Normalize();
+	float flightTime = distance / Projectile::PLAYER_SPEED;
+
+	Vec2 relativeVelocity = target->GetVelocity() - ship->GetVelocity();
+
+	return target->GetPosition() + relativeVelocity * flightTime;
+}
+
+float Autopilot::GetHeadingError(float heading, const Vec2 &direction)
+{
+	// Ship heading is measured clockwise from the positive X axis (see Ship::ProcessInput).
+	float targetHeading = RAD_TO_DEG(atan2f(-direction.y(), direction.x()));
+	float error = targetHeading - heading;
+
+	while (error > 180.0f) error -= 360.0f;
+	while (error < -180.0f) error += 360.0f;
+
+	return error;
+}
+
+float Autopilot::GetSteering(float headingError)
+{
+	// Steer at full speed until the ship is close to the target heading to avoid oscillating.
+	float steering = headingError / STEERING_ANGLE;
+
+	if (steering > 1) return 1;
+	if (steering < -1) return -1;
+
+	return steering;
+}
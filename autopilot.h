@@ -0,0 +1,50 @@
+#pragma once
+
+#include "gamedefs.h"
+#include "vector.h"
+
+// -------------------------------------------------------------------------------------------------
+
+// A simple computer player which flies the player's ship for soak tests and benchmarks. The
+// autopilot steers towards the nearest asteroid or UFO, shoots at it, evades asteroids which get
+// too close, and confirms respawns and level transitions. It produces the same virtual button
+// values as the keyboard so the rest of the game can't tell the difference.
+class Autopilot
+{
+public:
+	Autopilot(void);
+	~Autopilot(void);
+
+	void Update(Game *game);
+
+	float GetSteering(void) const { return m_steering; }
+	float GetAcceleration(void) const { return m_acceleration; }
+	bool IsFiring(void) const { return m_isFiring; }
+	bool IsPressingConfirm(void) const { return m_isConfirming; }
+
+private:
+	void FlyShip(Game *game, Ship *ship);
+	void ProcessConfirm(bool needsConfirm);
+
+	Entity *FindNearestTarget(Game *game, const Vec2 &position) const;
+	Vec2 CalculateAimPoint(const Ship *ship, const Entity *target) const;
+
+	static float GetHeadingError(float heading, const Vec2 &direction);
+	static float GetSteering(float headingError);
+
+private:
+	static constexpr float FIRE_RANGE = 22.0f; // Units, a bit less than projectile travel distance
+	static constexpr float FIRE_ANGLE = 8.0f; // Max degrees off target when firing
+	static constexpr float STEERING_ANGLE = 15.0f; // Degrees off target where steering is at full
+	static constexpr float APPROACH_DISTANCE = 15.0f; // Distance to keep from the target
+	static constexpr float CRUISE_SPEED = 8.0f; // Units/sec
+	static constexpr float EVADE_DISTANCE = 5.0f; // Extra distance to keep from asteroids
+	static constexpr float CONFIRM_DELAY = 1.0f; // Seconds to wait before pressing confirm
+
+	float m_steering = 0;
+	float m_acceleration = 0;
+	bool m_isFiring = false;
+	bool m_isConfirming = false;
+
+	float m_confirmTime = 0;
+};
@@ -0,0 +1,162 @@
+#include "benchmark.h"
+#include "game.h"
+#include "collisionhandler.h"
+#include "lighthandler.h"
+#include "effecthandler.h"
+#include "utils.h"
+#include <mylly/core/mylly.h>
+#include <mylly/core/time.h>
+
+// -------------------------------------------------------------------------------------------------
+
+constexpr const char *Benchmark::LOG_FILE;
+
+// -------------------------------------------------------------------------------------------------
+
+Benchmark::Benchmark(uint32_t level, float duration)
+{
+	m_level = level;
+	m_duration = duration;
+
+	m_log = fopen(LOG_FILE, "w");
+
+	if (m_log != nullptr) {
+		fprintf(m_log, "frame,frame_ms,engine_ms,update_ms,entities,lights,particles\n");
+	}
+}
+
+Benchmark::~Benchmark(void)
+{
+	if (m_log != nullptr) {
+		fclose(m_log);
+	}
+}
+
+void Benchmark::BeginUpdate(void)
+{
+	m_updateStart = std::chrono::steady_clock::now();
+
+	// Everything the main thread did since the end of the previous update was engine work. Unlike
+	// the CPU time of the process, this doesn't include the engine's worker threads.
+	if (m_hasUpdated) {
+
+		std::chrono::duration<float> engineTime = m_updateStart - m_updateEnd;
+		m_engineTime = engineTime.count();
+	}
+}
+
+void Benchmark::EndUpdate(Game *game)
+{
+	m_updateEnd = std::chrono::steady_clock::now();
+	m_hasUpdated = true;
+
+	std::chrono::duration<float> updateTime = m_updateEnd - m_updateStart;
+
+	if (m_isFinished ||
+		game->GetScene() == nullptr) {
+
+		return;
+	}
+
+	// Count the duration in game time so each run records the same frames.
+	float time = Utils::GetTime();
+
+	// The duration is counted from the first level load so completing levels doesn't extend the run.
+	if (m_startTime != 0 &&
+		time - m_startTime >= WARMUP_TIME + m_duration) {
+
+		Finish("completed");
+		return;
+	}
+
+	if (game->IsLoadingLevel()) {
+
+		m_sceneStartTime = 0;
+		return;
+	}
+
+	if (game->GetScene()->GetType() == SCENE_MENU) {
+
+		// Start the benchmark level from the main menu. If the menu is reached again, the
+		// autopilot has lost all of its ships.
+		if (m_hasStarted) {
+
+			Finish("game over");
+			return;
+		}
+
+		// Seed the random number generator only now, after the engine and the main menu have
+		// had their turn with it.
+		Utils::SetRandomSeed(RANDOM_SEED);
+
+		game->StartNewGame(m_level);
+		m_hasStarted = true;
+		return;
+	}
+
+	if (m_startTime == 0) {
+		m_startTime = time;
+	}
+
+	if (m_sceneStartTime == 0) {
+		m_sceneStartTime = time;
+	}
+
+	// Let the level settle (fade in, warp effect) before recording.
+	if (time - m_sceneStartTime < WARMUP_TIME) {
+		return;
+	}
+
+	RecordFrame(game, m_engineTime, updateTime.count());
+}
+
+void Benchmark::RecordFrame(Game *game, float engineTime, float updateTime)
+{
+	float frameTime = get_time().real_delta_time;
+
+	m_frameCount++;
+	m_totalFrameTime += frameTime;
+	m_totalEngineTime += engineTime;
+	m_totalUpdateTime += updateTime;
+
+	if (frameTime > m_maxFrameTime) { m_maxFrameTime = frameTime; }
+	if (engineTime > m_maxEngineTime) { m_maxEngineTime = engineTime; }
+	if (updateTime > m_maxUpdateTime) { m_maxUpdateTime = updateTime; }
+
+	if (m_log != nullptr) {
+
+		Scene *scene = game->GetScene();
+
+		fprintf(m_log, "%u,%.3f,%.3f,%.3f,%u,%u,%u\n",
+		        m_frameCount, 1000 * frameTime, 1000 * engineTime, 1000 * updateTime,
+		        game->GetCollisionHandler()->GetEntityCount(),
+		        scene->GetLightHandler()->GetActiveLightCount(),
+		        scene->GetEffectHandler()->GetLiveParticleCount());
+	}
+}
+
+void Benchmark::Finish(const char *reason)
+{
+	m_isFinished = true;
+
+	if (m_frameCount != 0) {
+
+		printf("Benchmark %s: %u frames, frame %.3f ms avg %.3f ms max, "
+		       "engine %.3f ms avg %.3f ms max, update %.3f ms avg %.3f ms max.\n",
+		       reason, m_frameCount,
+		       1000 * m_totalFrameTime / m_frameCount, 1000 * m_maxFrameTime,
+		       1000 * m_totalEngineTime / m_frameCount, 1000 * m_maxEngineTime,
+		       1000 * m_totalUpdateTime / m_frameCount, 1000 * m_maxUpdateTime);
+	}
+	else {
+		printf("Benchmark %s: no frames recorded.\n", reason);
+	}
+
+	if (m_log != nullptr) {
+
+		fclose(m_log);
+		m_log = nullptr;
+	}
+
+	mylly_exit();
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "gamedefs.h"
+#include <stdio.h>
+#include <chrono>
+
+// -------------------------------------------------------------------------------------------------
+
+// Plays a level with the autopilot for a fixed time and records for each frame the time spent in the
+// game's update and the time the main thread spends in the engine between two updates: submitting
+// the previous frame to the renderer, swapping buffers and updating the engine's own systems. The
+// game runs with a fixed time step, the random seed is fixed when the level starts and camera
+// shake is disabled, so consecutive runs simulate the same frames.
+//
+// The engine has no headless or offscreen mode and no GPU timer queries yet. The benchmark needs a
+// window, and the engine time includes waiting for vsync unless it is disabled in the driver.
+class Benchmark
+{
+public:
+	Benchmark(uint32_t level, float duration);
+	~Benchmark(void);
+
+	// Call these around the game's update.
+	void BeginUpdate(void);
+	void EndUpdate(Game *game);
+
+private:
+	void RecordFrame(Game *game, float engineTime, float updateTime);
+	void Finish(const char *reason);
+
+public:
+	static constexpr float TIME_STEP = 1.0f / 60; // Game time advanced on each frame, seconds
+
+private:
+	static constexpr float WARMUP_TIME = 1.0f; // Seconds to play after a level load before recording
+	static constexpr uint32_t RANDOM_SEED = 1234;
+	static constexpr const char *LOG_FILE = "benchmark.csv";
+
+	uint32_t m_level = 1;
+	float m_duration = 0; // Seconds to record
+
+	bool m_hasStarted = false;
+	bool m_isFinished = false;
+	float m_startTime = 0; // Game time when the first level finished loading
+	float m_sceneStartTime = 0; // Time when the current level finished loading, 0 while loading
+
+	std::chrono::steady_clock::time_point m_updateStart;
+	std::chrono::steady_clock::time_point m_updateEnd; // End of the previous update
+	bool m_hasUpdated = false;
+	float m_engineTime = 0; // Time between the previous update and the current one
+
+	uint32_t m_frameCount = 0;
+	float m_totalFrameTime = 0;
+	float m_totalEngineTime = 0;
+	float m_totalUpdateTime = 0;
+	float m_maxFrameTime = 0;
+	float m_maxEngineTime = 0;
+	float m_maxUpdateTime = 0;
+
+	FILE *m_log = nullptr;
+};
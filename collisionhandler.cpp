@@ -1,5 +1,7 @@
 #include "collisionhandler.h"
 #include "entity.h"
+#include "perfcounters.h"
+#include "probes.h"
 
 // -------------------------------------------------------------------------------------------------
 
@@ -39,6 +41,8 @@ void CollisionHandler::UnregisterAllEntities(void)
 void CollisionHandler::Update(const Game *game)
 {
 	UNUSED(game);
+
+	GAME_PROBE1(collision_start, m_entities.count);
 	
 	// This could be optimized a lot by i.e. keeping track of the entities we've checked, but since
 	// the object count in the game is so low I'm not going to bother.
@@ -59,15 +63,21 @@ void CollisionHandler::Update(const Game *game)
 
 			Entity *other = m_entities.items[j];
 
+			PerfCounters::Increment(COUNTER_COLLISION_PAIRS);
+
 			if (EntitiesCollide(entity, other)) {
 
 				if (/*entity->WasCollidingWith(other) ||*/ other->IsColliding()) {
 					continue;
 				}
 
+				PerfCounters::Increment(COUNTER_COLLISION_CONTACTS);
+
 				// Detected a collision! Apply collision response and notify both entities.
 				if (entity->IsCollidable() && other->IsCollidable()) {
+
 					ApplyCollisionResponse(entity, other);
+					PerfCounters::Increment(COUNTER_COLLISION_RESPONSES);
 				}
 
 				entity->OnCollideWith(game, other);
@@ -75,6 +85,7 @@ void CollisionHandler::Update(const Game *game)
 			}
 		}
 	}
+	GAME_PROBE1(collision_end, m_entities.count);
 }
 
 bool CollisionHandler::Contains(Entity *entity) const
@@ -17,6 +17,8 @@ public:
 
 	void Update(const Game *game);
 
+	uint32_t GetEntityCount(void) const { return m_entities.count; }
+
 private:
 	bool Contains(Entity *entity) const;
 	bool EntitiesCollide(Entity *entity1, Entity* entity2) const;
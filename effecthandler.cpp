@@ -0,0 +1,369 @@
+#include "effecthandler.h"
+#include "perfcounters.h"
+#include "utils.h"
+#include <mylly/scene/scene.h>
+#include <mylly/scene/object.h>
+#include <mylly/scene/emitter.h>
+#include <mylly/resources/resources.h>
+#include <string.h>
+#include <math.h>
+
+// -------------------------------------------------------------------------------------------------
+
+// Estimated cost of the one-shot effects, calculated from the .fx files including subemitters.
+// The particle count is the peak number of particles (initial burst + emit rate * emit duration)
+// and the lifetime is the time it takes for all particles to die. Trails follow an entity for an
+// unknown time, so they are not included.
+struct EffectCost {
+
+	const char *effectName;
+	uint32_t particles;
+	float lifetime; // Seconds
+	EffectPriority priority;
+};
+
+static const EffectCost effectCosts[] = {
+	{ "projectile-hit", 25, 0.2f, EFFECT_PRIORITY_LOW },
+	{ "projectile2-hit", 25, 0.2f, EFFECT_PRIORITY_LOW },
+	{ "asteroid-dust", 25, 3.0f, EFFECT_PRIORITY_LOW },
+	{ "asteroid-explosion", 145, 4.0f, EFFECT_PRIORITY_NORMAL },
+	{ "ship-explosion", 415, 4.1f, EFFECT_PRIORITY_HIGH },
+	{ "ftl", 360, 1.8f, EFFECT_PRIORITY_HIGH },
+};
+
+static const uint32_t NUM_EFFECT_COSTS = sizeof(effectCosts) / sizeof(effectCosts[0]);
+
+// Share of the particle budget each priority level may use.
+static const float priorityBudgets[] = {
+	0.5f, // EFFECT_PRIORITY_LOW
+	1.0f, // EFFECT_PRIORITY_NORMAL
+	-1.0f, // EFFECT_PRIORITY_HIGH, unlimited
+};
+
+// Effects which are worth pooling and the number of instances in each pool.
+struct PooledEffect {
+
+	const char *effectName;
+	uint32_t instances;
+};
+
+static const PooledEffect pooledEffects[] = {
+	{ "projectile-hit", 8 },
+	{ "projectile2-hit", 8 },
+	{ "asteroid-explosion", 8 },
+	{ "asteroid-dust", 8 },
+	{ "ship-explosion", 2 },
+};
+
+static const uint32_t NUM_POOLED_EFFECTS = sizeof(pooledEffects) / sizeof(pooledEffects[0]);
+
+// Spawn rate budgets for effects which repeated collision contacts trigger from the same spot, such
+// as overlapping asteroids. Spawns over the budget are dropped since a matching effect is already
+// playing nearby. The total limit caps the cost of the effect no matter where it's spawned.
+// Effects of distinct events, such as an asteroid being destroyed, are never throttled.
+struct EffectBudget {
+
+	const char *effectName;
+	float cellSize; // Size of a grid cell in units
+	float window; // Time window in seconds
+	uint32_t maxPerCell; // Max spawns within a cell during the time window
+	uint32_t maxTotal; // Max spawns in the entire scene during the time window
+};
+
+static const EffectBudget effectBudgets[] = {
+	{ "asteroid-dust", 4.0f, 0.5f, 1, 6 },
+	{ "projectile-hit", 2.0f, 0.1f, 2, 8 },
+	{ "projectile2-hit", 2.0f, 0.1f, 2, 8 },
+};
+
+static const uint32_t NUM_EFFECT_BUDGETS = sizeof(effectBudgets) / sizeof(effectBudgets[0]);
+
+static const EffectCost *GetEffectCost(const char *effectName)
+{
+	for (uint32_t i = 0; i < NUM_EFFECT_COSTS; i++) {
+
+		if (strcmp(effectCosts[i].effectName, effectName) == 0) {
+			return &effectCosts[i];
+		}
+	}
+
+	return nullptr;
+}
+
+// Returns the index of the effect in the budget table, or NUM_EFFECT_BUDGETS if the effect has
+// no budget.
+static uint32_t GetEffectBudgetIndex(const char *effectName)
+{
+	for (uint32_t i = 0; i < NUM_EFFECT_BUDGETS; i++) {
+
+		if (strcmp(effectBudgets[i].effectName, effectName) == 0) {
+			return i;
+		}
+	}
+
+	return NUM_EFFECT_BUDGETS;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+EffectHandler::EffectHandler(scene_t *sceneRoot)
+{
+	m_pools = new EffectPool[NUM_POOLED_EFFECTS];
+
+	for (uint32_t i = 0; i < NUM_POOLED_EFFECTS; i++) {
+
+		const PooledEffect &definition = pooledEffects[i];
+		const EffectCost *cost = GetEffectCost(definition.effectName);
+		emitter_t *effect = res_get_emitter(definition.effectName);
+
+		if (effect == nullptr ||
+			cost == nullptr) {
+
+			continue;
+		}
+
+		EffectPool &pool = m_pools[m_poolCount++];
+
+		pool.effectName = definition.effectName;
+		pool.lifetime = cost->lifetime;
+		pool.instanceCount = 0;
+		pool.nextInstance = 0;
+
+		// Create the emitters up front. They are never destroyed while the scene is alive.
+		for (uint32_t j = 0; j < definition.instances && j < MAX_EFFECT_INSTANCES; j++) {
+
+			object_t *effectObject = Utils::CreateObject(sceneRoot);
+			emitter_t *emitter = obj_add_emitter(effectObject, effect);
+
+			// Rotate the object towards the camera.
+			obj_set_local_rotation(effectObject, quat_from_euler_deg(90, 0, 0));
+			emitter_set_destroy_when_inactive(emitter, false);
+
+			pool.instances[pool.instanceCount] = emitter;
+			pool.spawnTimes[pool.instanceCount] = -cost->lifetime;
+			pool.instanceCount++;
+		}
+	}
+}
+
+EffectHandler::~EffectHandler(void)
+{
+	for (uint32_t i = 0; i < m_poolCount; i++) {
+		for (uint32_t j = 0; j < m_pools[i].instanceCount; j++) {
+			obj_destroy(m_pools[i].instances[j]->parent);
+		}
+	}
+
+	delete[] m_pools;
+}
+
+emitter_t *EffectHandler::SpawnEffect(const char *effectName, const Vec2 &position)
+{
+	EffectPool *pool = GetPool(effectName);
+
+	if (pool == nullptr ||
+		pool->instanceCount == 0) {
+
+		return nullptr;
+	}
+
+	// Reuse the oldest instance, but only if its particles have already died out. Otherwise the
+	// caller has to spawn a new emitter.
+	float time = Utils::GetTime();
+	uint32_t index = pool->nextInstance;
+
+	if (time - pool->spawnTimes[index] < pool->lifetime) {
+		return nullptr;
+	}
+
+	emitter_t *emitter = pool->instances[index];
+
+	pool->spawnTimes[index] = time;
+	pool->nextInstance = (index + 1) % pool->instanceCount;
+
+	// Move the emitter to the desired position and restart it.
+	obj_set_position(emitter->parent, vec3(position.x(), 0, position.y()));
+
+	if (emitter->is_emitting) {
+		emitter_stop(emitter);
+	}
+
+	emitter_start(emitter);
+
+	PerfCounters::Increment(COUNTER_EFFECTS_SPAWNED);
+
+	return emitter;
+}
+
+bool EffectHandler::IsThrottled(const char *effectName, const Vec2 &position)
+{
+	// Effects without a budget are never throttled.
+	uint32_t budgetIndex = GetEffectBudgetIndex(effectName);
+
+	if (budgetIndex == NUM_EFFECT_BUDGETS) {
+		return false;
+	}
+
+	const EffectBudget &budget = effectBudgets[budgetIndex];
+
+	float time = Utils::GetTime();
+	int32_t cellX, cellY;
+
+	GetSpawnCell(budgetIndex, position, cellX, cellY);
+
+	uint32_t spawnsInCell = 0, spawnsTotal = 0;
+
+	for (uint32_t i = 0; i < m_recentSpawnCount;) {
+
+		const EffectSpawn &spawn = m_recentSpawns[i];
+
+		// Forget spawns which are older than the longest time window.
+		if (time - spawn.time > MAX_SPAWN_WINDOW) {
+
+			m_recentSpawns[i] = m_recentSpawns[--m_recentSpawnCount];
+			continue;
+		}
+
+		if (spawn.budget == budgetIndex &&
+			time - spawn.time < budget.window) {
+
+			++spawnsTotal;
+
+			if (spawn.cellX == cellX && spawn.cellY == cellY) {
+				++spawnsInCell;
+			}
+		}
+
+		i++;
+	}
+
+	if (spawnsInCell >= budget.maxPerCell ||
+		spawnsTotal >= budget.maxTotal ||
+		m_recentSpawnCount >= MAX_RECENT_SPAWNS) {
+
+		PerfCounters::Increment(COUNTER_EFFECTS_THROTTLED);
+		return true;
+	}
+
+	return false;
+}
+
+void EffectHandler::RecordSpawn(const char *effectName, const Vec2 &position)
+{
+	uint32_t budgetIndex = GetEffectBudgetIndex(effectName);
+
+	if (budgetIndex == NUM_EFFECT_BUDGETS ||
+		m_recentSpawnCount >= MAX_RECENT_SPAWNS) {
+
+		return;
+	}
+
+	EffectSpawn &spawn = m_recentSpawns[m_recentSpawnCount++];
+
+	spawn.budget = budgetIndex;
+	spawn.time = Utils::GetTime();
+
+	GetSpawnCell(budgetIndex, position, spawn.cellX, spawn.cellY);
+}
+
+bool EffectHandler::IsCullable(const char *effectName) const
+{
+	const EffectCost *cost = GetEffectCost(effectName);
+
+	return (cost != nullptr && cost->priority != EFFECT_PRIORITY_HIGH);
+}
+
+bool EffectHandler::ReserveParticles(const char *effectName)
+{
+	const EffectCost *cost = GetEffectCost(effectName);
+
+	if (cost == nullptr) {
+		return true;
+	}
+
+	// Forget effects which have already died out.
+	float time = Utils::GetTime();
+
+	for (uint32_t i = 0; i < m_liveEffectCount;) {
+
+		if (m_liveEffects[i].endTime <= time) {
+
+			m_liveParticles -= m_liveEffects[i].particles;
+			m_liveEffects[i] = m_liveEffects[--m_liveEffectCount];
+			continue;
+		}
+
+		i++;
+	}
+
+	// Small and short lived effects are only allowed to use a part of the budget so there's always
+	// room left for the more important effects. When the list of live effects is full, only the
+	// most important effects are spawned.
+	float budgetShare = priorityBudgets[cost->priority];
+
+	if (budgetShare >= 0 &&
+		(m_liveEffectCount >= MAX_LIVE_EFFECTS ||
+		 m_liveParticles + cost->particles > budgetShare * m_particleBudget)) {
+
+		PerfCounters::Increment(COUNTER_EFFECTS_THROTTLED);
+		return false;
+	}
+
+	if (m_liveEffectCount < MAX_LIVE_EFFECTS) {
+
+		LiveEffect &effect = m_liveEffects[m_liveEffectCount++];
+
+		effect.particles = cost->particles;
+		effect.endTime = time + cost->lifetime;
+
+		m_liveParticles += cost->particles;
+	}
+
+	return true;
+}
+
+void EffectHandler::ReleaseParticles(const char *effectName)
+{
+	const EffectCost *cost = GetEffectCost(effectName);
+
+	if (cost == nullptr) {
+		return;
+	}
+
+	// The reservation was made this frame, so it's the latest live effect with the same end time.
+	float endTime = Utils::GetTime() + cost->lifetime;
+
+	for (uint32_t i = m_liveEffectCount; i > 0; i--) {
+
+		LiveEffect &effect = m_liveEffects[i - 1];
+
+		if (effect.particles == cost->particles &&
+			effect.endTime == endTime) {
+
+			m_liveParticles -= effect.particles;
+			effect = m_liveEffects[--m_liveEffectCount];
+			return;
+		}
+	}
+}
+
+void EffectHandler::GetSpawnCell(uint32_t budgetIndex, const Vec2 &position,
+                                 int32_t &outX, int32_t &outY) const
+{
+	float cellSize = effectBudgets[budgetIndex].cellSize;
+
+	outX = (int32_t)floorf(position.x() / cellSize);
+	outY = (int32_t)floorf(position.y() / cellSize);
+}
+
+EffectPool *EffectHandler::GetPool(const char *effectName)
+{
+	for (uint32_t i = 0; i < m_poolCount; i++) {
+
+		if (strcmp(m_pools[i].effectName, effectName) == 0) {
+			return &m_pools[i];
+		}
+	}
+
+	return nullptr;
+}
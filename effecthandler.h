@@ -0,0 +1,99 @@
+#pragma once
+
+#include "gamedefs.h"
+#include "vector.h"
+
+// -------------------------------------------------------------------------------------------------
+
+enum EffectPriority {
+
+	EFFECT_PRIORITY_LOW, // Small or short lived effects, dropped first when there are too many particles
+	EFFECT_PRIORITY_NORMAL,
+	EFFECT_PRIORITY_HIGH, // Effects which are never dropped
+};
+
+// -------------------------------------------------------------------------------------------------
+
+static constexpr uint32_t MAX_EFFECT_INSTANCES = 8; // Max number of pooled instances per effect
+
+// A pool of pre-warmed emitters for a single effect.
+struct EffectPool {
+	const char *effectName;
+	float lifetime; // Max time the particles of the effect (including subemitters) stay alive
+	emitter_t *instances[MAX_EFFECT_INSTANCES];
+	float spawnTimes[MAX_EFFECT_INSTANCES]; // Time each instance was last started
+	uint32_t instanceCount;
+	uint32_t nextInstance; // Instances are reused in a round robin fashion
+};
+
+// A recently spawned effect, used for limiting the rate at which effects are spawned.
+struct EffectSpawn {
+	uint32_t budget; // Index to the budget table
+	int32_t cellX, cellY; // Grid cell the effect was spawned in
+	float time;
+};
+
+// Estimated cost of an effect which is still alive.
+struct LiveEffect {
+	uint32_t particles;
+	float endTime;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+// Keeps pools of pre-warmed particle emitters for short one-shot effects such as hits and
+// explosions. Instead of creating a new object and an emitter for each effect, the oldest instance
+// of the effect is moved to the new position and restarted in place. The handler also keeps
+// the number of effects in check by limiting how often an effect can be spawned and by keeping an
+// estimate of the particles alive in the scene.
+class EffectHandler
+{
+public:
+	EffectHandler(scene_t *sceneRoot);
+	~EffectHandler(void);
+
+	emitter_t *SpawnEffect(const char *effectName, const Vec2 &position);
+
+	// Returns true if the effect has been spawned too many times near the position recently.
+	bool IsThrottled(const char *effectName, const Vec2 &position);
+
+	// Records a spawn of the effect for throttling. Call after the effect has actually been spawned.
+	void RecordSpawn(const char *effectName, const Vec2 &position);
+
+	// Returns true if the effect is not important enough to be spawned outside the view.
+	bool IsCullable(const char *effectName) const;
+
+	// Reserves room for the particles of the effect from the global particle budget. Returns
+	// false if the effect should be dropped to stay within the budget.
+	bool ReserveParticles(const char *effectName);
+
+	// Returns the particles reserved for an effect this frame if it couldn't be spawned after all.
+	void ReleaseParticles(const char *effectName);
+
+	uint32_t GetParticleBudget(void) const { return m_particleBudget; }
+	void SetParticleBudget(uint32_t particles) { m_particleBudget = particles; }
+
+	uint32_t GetLiveParticleCount(void) const { return m_liveParticles; }
+
+private:
+	EffectPool *GetPool(const char *effectName);
+	void GetSpawnCell(uint32_t budgetIndex, const Vec2 &position, int32_t &outX, int32_t &outY) const;
+
+private:
+	static constexpr uint32_t MAX_RECENT_SPAWNS = 64;
+	static constexpr float MAX_SPAWN_WINDOW = 0.5f; // Longest time window in the budget table
+
+	EffectPool *m_pools = nullptr;
+	uint32_t m_poolCount = 0;
+
+	EffectSpawn m_recentSpawns[MAX_RECENT_SPAWNS];
+	uint32_t m_recentSpawnCount = 0;
+
+	static constexpr uint32_t MAX_LIVE_EFFECTS = 128;
+	static constexpr uint32_t DEFAULT_PARTICLE_BUDGET = 2000;
+
+	LiveEffect m_liveEffects[MAX_LIVE_EFFECTS];
+	uint32_t m_liveEffectCount = 0;
+	uint32_t m_liveParticles = 0; // Estimated number of particles alive
+	uint32_t m_particleBudget = DEFAULT_PARTICLE_BUDGET;
+};
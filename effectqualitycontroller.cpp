@@ -0,0 +1,153 @@
+#include "effectqualitycontroller.h"
+#include "game.h"
+#include "framestats.h"
+#include "lighthandler.h"
+#include "effecthandler.h"
+#include <mylly/core/time.h>
+
+// -------------------------------------------------------------------------------------------------
+
+struct QualityLevel {
+
+	uint32_t maxLights; // Point lights in the light handler's budget
+	uint32_t particleBudget; // Estimated particles alive at once
+};
+
+static const QualityLevel qualityLevels[] = {
+	{ 16, 2000 }, // 0
+	{ 12, 1500 }, // 1
+	{ 8, 1000 }, // 2
+	{ 4, 600 }, // 3
+};
+
+// -------------------------------------------------------------------------------------------------
+
+EffectQualityController::EffectQualityController(void)
+{
+	m_averageFrameTime = FrameStats::FRAME_BUDGET;
+}
+
+void EffectQualityController::Update(Game *game)
+{
+	Scene *scene = game->GetScene();
+
+	if (scene == nullptr ||
+		game->IsLoadingLevel()) {
+
+		return;
+	}
+
+	// The handlers are recreated with each scene, so the level is applied again after a scene
+	// change as well as when the level changes.
+	if (!m_isLevelApplied) {
+		ApplyLevel(scene);
+	}
+
+	// Only measure frames in the actual game, the menu and the pause screen don't tell anything
+	// about the cost of the effects.
+	if (!m_isEnabled ||
+		scene->GetType() != SCENE_GAME ||
+		game->IsPaused()) {
+
+		return;
+	}
+
+	// The first frames of a scene include the loading hitch, don't react to them.
+	if (m_settleFrames != 0) {
+
+		--m_settleFrames;
+		return;
+	}
+
+	float frameTime = get_time().real_delta_time;
+	m_averageFrameTime += SMOOTHING * (frameTime - m_averageFrameTime);
+	m_timeSinceUpgrade += frameTime;
+
+	// Lower the quality quickly when the frame rate drops, but be slow to raise it again so the
+	// level doesn't keep oscillating.
+	if (m_averageFrameTime > DOWNGRADE_THRESHOLD * FrameStats::FRAME_BUDGET) {
+
+		m_timeOverBudget += frameTime;
+		m_timeUnderBudget = 0;
+
+		if (m_timeOverBudget >= DOWNGRADE_DELAY &&
+			m_level + 1 < GetLevelCount()) {
+
+			// If the previous upgrade didn't hold, the scene can't afford that level. Don't try it
+			// again, otherwise a machine which barely makes the budget keeps stuttering on retries.
+			if (m_hasUpgraded &&
+				m_timeSinceUpgrade < UPGRADE_HOLD_TIME) {
+
+				m_highestLevel = m_level + 1;
+			}
+
+			m_hasUpgraded = false;
+			SetQualityLevel(m_level + 1);
+		}
+	}
+	else if (m_averageFrameTime < UPGRADE_THRESHOLD * FrameStats::FRAME_BUDGET) {
+
+		m_timeUnderBudget += frameTime;
+		m_timeOverBudget = 0;
+
+		if (m_timeUnderBudget >= UPGRADE_DELAY &&
+			m_level > m_highestLevel) {
+
+			m_hasUpgraded = true;
+			m_timeSinceUpgrade = 0;
+
+			SetQualityLevel(m_level - 1);
+		}
+	}
+	else {
+
+		m_timeOverBudget = 0;
+		m_timeUnderBudget = 0;
+	}
+}
+
+void EffectQualityController::OnSceneChanged(void)
+{
+	// Levels differ in cost, so start over from the highest quality and measure again once the
+	// scene has settled.
+	if (m_isEnabled) {
+		SetQualityLevel(0);
+	}
+
+	m_averageFrameTime = FrameStats::FRAME_BUDGET;
+	m_highestLevel = 0;
+	m_timeSinceUpgrade = 0;
+	m_hasUpgraded = false;
+	m_settleFrames = SETTLE_FRAMES;
+	m_isLevelApplied = false;
+}
+
+void EffectQualityController::SetQualityLevel(uint32_t level)
+{
+	if (level >= GetLevelCount()) {
+		level = GetLevelCount() - 1;
+	}
+
+	if (level != m_level) {
+		m_isLevelApplied = false;
+	}
+
+	m_level = level;
+	m_timeOverBudget = 0;
+	m_timeUnderBudget = 0;
+}
+
+uint32_t EffectQualityController::GetLevelCount(void)
+{
+	return LENGTH(qualityLevels);
+}
+
+void EffectQualityController::ApplyLevel(Scene *scene)
+{
+	const QualityLevel &level = qualityLevels[m_level];
+
+	scene->GetLightHandler()->SetMaxLights(level.maxLights);
+	scene->GetEffectHandler()->SetParticleBudget(level.particleBudget);
+
+	m_isLevelApplied = true;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "gamedefs.h"
+
+// -------------------------------------------------------------------------------------------------
+
+// Scales the cost of the visual effects up and down based on the measured frame time. When frames
+// take longer than the frame budget, the controller lowers the number of point lights and the
+// particle budget of the scene. When frames fit in the budget again it slowly raises them back.
+// Each scene starts from the highest quality since the cost of the levels differs.
+//
+// This only covers the CPU and shading cost of the effects, not fill rate. Rendering the scene and
+// the post processing pass at a lower resolution needs a scalable render target in the engine's
+// renderer, which doesn't exist yet. Once it does, the resolution scale should become another
+// column of the quality levels, lowered only after the effects have been reduced.
+class EffectQualityController
+{
+public:
+	EffectQualityController(void);
+
+	void Update(Game *game);
+	void OnSceneChanged(void);
+
+	uint32_t GetQualityLevel(void) const { return m_level; }
+	void SetQualityLevel(uint32_t level);
+
+	// When disabled, the quality level stays where it is.
+	bool IsEnabled(void) const { return m_isEnabled; }
+	void SetEnabled(bool isEnabled) { m_isEnabled = isEnabled; }
+
+	static uint32_t GetLevelCount(void);
+
+private:
+	void ApplyLevel(Scene *scene);
+
+private:
+	static constexpr float SMOOTHING = 0.1f; // Weight of the latest frame in the average frame time
+	static constexpr float DOWNGRADE_THRESHOLD = 1.1f; // Relative to the frame budget
+
+	// Quality is only raised when frames have clear headroom. Vsync never lets the frame time go
+	// below the budget, so with vsync a lowered level holds until the next scene.
+	static constexpr float UPGRADE_THRESHOLD = 0.85f;
+
+	static constexpr float DOWNGRADE_DELAY = 0.5f; // Seconds over budget before lowering quality
+	static constexpr float UPGRADE_DELAY = 3.0f; // Seconds under budget before raising quality
+	static constexpr float UPGRADE_HOLD_TIME = 10.0f; // An upgrade lowered sooner than this failed
+	static constexpr uint32_t SETTLE_FRAMES = 30; // Frames ignored after a scene has been loaded
+
+	bool m_isEnabled = true;
+	uint32_t m_level = 0; // 0 is the highest quality
+	bool m_isLevelApplied = false; // Set once the level has been applied to the current scene
+
+	float m_averageFrameTime = 0;
+	float m_timeOverBudget = 0;
+	float m_timeUnderBudget = 0;
+
+	// A level which was too slow right after raising the quality is not retried in the same scene.
+	uint32_t m_highestLevel = 0;
+	float m_timeSinceUpgrade = 0;
+	bool m_hasUpgraded = false;
+
+	uint32_t m_settleFrames = SETTLE_FRAMES;
+};
@@ -3,6 +3,7 @@
 #include "collisionhandler.h"
 #include "editor/editor.h"
 #include <mylly/scene/object.h>
+#include <mylly/scene/emitter.h>
 #include <mylly/renderer/debug.h>
 
 // -------------------------------------------------------------------------------------------------
@@ -75,17 +76,88 @@ void Entity::Update(Game *game)
 	if (!game->IsWithinBoundaries(GetPosition())) {
 		SetPosition(game->WrapBoundaries(GetPosition()));
 	}
+
+	UpdateVisibility(game);
+}
+
+void Entity::UpdateVisibility(Game *game)
+{
+	bool isVisible = game->IsInView(m_position, m_boundingRadius);
+
+	if (isVisible == m_isVisible ||
+		m_sceneObject == nullptr) {
+
+		return;
+	}
+
+	m_isVisible = isVisible;
+
+	// Entities outside the view are not rendered or lit, and their scene object transforms are
+	// not updated. Move the object to where the entity is now when it comes back into view.
+	SetVisualsActive(isVisible);
+
+	if (isVisible) {
+		obj_set_position(m_sceneObject, vec3(m_position.x(), m_drawDepth, m_position.y()));
+	}
+
+	OnVisibilityChanged(game, isVisible);
+}
+
+void Entity::SetVisualsActive(bool isActive)
+{
+	obj_set_active(m_sceneObject, isActive);
 }
 
 void Entity::SetPosition(const Vec2 &position)
 {
 	m_position = position;
 
-	if (m_sceneObject != nullptr) {
+	if (m_sceneObject != nullptr && m_isVisible) {
 		obj_set_position(m_sceneObject, vec3(m_position.x(), m_drawDepth, m_position.y()));
 	}
 }
 
+void Entity::AttachEmitter(emitter_t *emitter, const vec3_t &localPosition,
+                           const quat_t &localRotation, float localScale)
+{
+	if (emitter == nullptr ||
+		m_sceneObject == nullptr) {
+
+		return;
+	}
+
+	object_t *emitterObject = emitter->parent;
+
+	obj_set_parent(emitterObject, m_sceneObject);
+	obj_set_local_position(emitterObject, localPosition);
+	obj_set_local_rotation(emitterObject, localRotation);
+	obj_set_local_scale(emitterObject, vec3(localScale, localScale, localScale));
+
+	// The emitter is destroyed along with the entity unless it's detached first.
+	emitter_set_destroy_when_inactive(emitter, false);
+}
+
+void Entity::DetachEmitter(emitter_t *emitter, const vec3_t &position, const quat_t &rotation)
+{
+	if (emitter == nullptr) {
+		return;
+	}
+
+	object_t *emitterObject = emitter->parent;
+
+	obj_set_parent(emitterObject, nullptr);
+	obj_set_position(emitterObject, position);
+	obj_set_local_rotation(emitterObject, rotation);
+	obj_set_local_scale(emitterObject, vec3(1, 1, 1));
+
+	// Make sure the emitter is active, otherwise it never finishes its particles and gets destroyed.
+	obj_set_active(emitterObject, true);
+
+	// Stop emitting and let the particles finish before the emitter destroys itself.
+	emitter_set_destroy_when_inactive(emitter, true);
+	emitter_stop(emitter);
+}
+
 void Entity::OnCollideWith(const Game *game, Entity *other)
 {
 	UNUSED(game);
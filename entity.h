@@ -2,6 +2,7 @@
 
 #include "gamedefs.h"
 #include "vector.h"
+#include <mylly/math/quaternion.h>
 
 // -------------------------------------------------------------------------------------------------
 
@@ -41,6 +42,7 @@ public:
 	float GetMass(void) const { return m_mass; }
 
 	bool IsSpawned(void) const { return (m_sceneObject != nullptr); }
+	bool IsVisible(void) const { return m_isVisible; }
 
 	bool IsCollidable(void) const { return m_isCollidable; }
 	bool IsColliding(void) const { return (m_collisionEntity != nullptr); }
@@ -60,6 +62,22 @@ protected:
 
 	void SetSceneObject(object_t *obj) { m_sceneObject = obj; }
 
+	// Parents a particle emitter to the entity's scene object so the engine moves it along with
+	// the entity. The local transform is relative to the entity's scene object.
+	void AttachEmitter(emitter_t *emitter, const vec3_t &localPosition, const quat_t &localRotation,
+	                   float localScale = 1.0f);
+
+	// Moves an attached emitter back to the scene root to the given world transform and lets it
+	// destroy itself once its particles have died out.
+	void DetachEmitter(emitter_t *emitter, const vec3_t &position, const quat_t &rotation);
+
+	// Shows or hides the entity's visuals. By default the whole scene object is deactivated,
+	// entities with attached emitters only hide their model or sprite so the particles stay visible.
+	virtual void SetVisualsActive(bool isActive);
+
+	// Called when the entity moves in or out of the camera's view.
+	virtual void OnVisibilityChanged(Game *game, bool isVisible) { UNUSED(game); UNUSED(isVisible); }
+
 	void SetCollidable(bool isCollidable) { m_isCollidable = isCollidable; }
 
 	void SetHealth(int health) { m_health = health; }
@@ -69,6 +87,8 @@ protected:
 private:
 	Entity(void);
 
+	void UpdateVisibility(Game *game);
+
 private:
 	object_t *m_sceneObject = nullptr;
 
@@ -78,6 +98,8 @@ private:
 	Vec2 m_velocity = Vec2();
 	float m_drawDepth = 0.0f;
 
+	bool m_isVisible = true; // Visuals of entities outside the view are deactivated
+
 	float m_boundingRadius = 1.0f;
 	float m_mass = 1.0f;
 
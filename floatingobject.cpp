@@ -2,7 +2,6 @@
 #include "game.h"
 #include "utils.h"
 #include <mylly/scene/object.h>
-#include <mylly/core/time.h>
 #include <mylly/math/math.h>
 
 // -------------------------------------------------------------------------------------------------
@@ -13,7 +12,7 @@ void FloatingObject::Update(Game *game)
 		return;
 	}
 
-	float dt = get_time().delta_time;
+	float dt = Utils::GetDeltaTime();
 
 	// Limit the asteroid's speed.
 	Vec2 velocity = GetVelocity();
@@ -31,7 +30,14 @@ void FloatingObject::Update(Game *game)
 	Vec2 movement = GetVelocity() * dt;
 	SetPosition(GetPosition() + movement);
 
-	// Rotate the asteroid.
+	// Rotate the asteroid. Asteroids outside the view keep their rotation until they become
+	// visible again.
+	if (!IsVisible()) {
+
+		Entity::Update(game);
+		return;
+	}
+
 	Vec2 direction = GetVelocity();
 	direction.Normalize();
 
@@ -40,9 +46,20 @@ void FloatingObject::Update(Game *game)
 
 	m_rotation += euler;
 
-	obj_set_local_rotation(GetSceneObject(),
-		quat_from_euler_deg(-m_rotation.x(), m_rotation.y(), -m_rotation.z()));
+	quat_t rotation = quat_from_euler_deg(-m_rotation.x(), m_rotation.y(), -m_rotation.z());
+	obj_set_local_rotation(GetSceneObject(), quat_multiply(rotation, m_modelRotation));
 
 	// Call base update to draw entity debug visualizers.
 	Entity::Update(game);
 }
+
+void FloatingObject::SetModelRotation(const quat_t &rotation)
+{
+	m_modelRotation = rotation;
+
+	if (IsSpawned()) {
+
+		quat_t floatingRotation = quat_from_euler_deg(-m_rotation.x(), m_rotation.y(), -m_rotation.z());
+		obj_set_local_rotation(GetSceneObject(), quat_multiply(floatingRotation, m_modelRotation));
+	}
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "entity.h"
+#include <mylly/math/quaternion.h>
 
 // -------------------------------------------------------------------------------------------------
 
@@ -13,7 +14,11 @@ protected:
 	FloatingObject(EntityType type) : Entity(type) {}
 	void SetMaxSpeed(float maxSpeed) { m_maxSpeed = maxSpeed; }
 
+	// Sets a fixed rotation for the model, applied before the rotation of the floating movement.
+	void SetModelRotation(const quat_t &rotation);
+
 private:
 	Vec3 m_rotation = Vec3();
+	quat_t m_modelRotation = quat_from_euler_deg(0, 0, 0);
 	float m_maxSpeed = 1.0f;
 };
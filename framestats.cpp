@@ -0,0 +1,189 @@
+#include "framestats.h"
+#include <math.h>
+#include <string.h>
+#include <time.h>
+
+// -------------------------------------------------------------------------------------------------
+
+constexpr float FrameStats::FRAME_BUDGET;
+constexpr float FrameStats::MIN_FRAME_TIME;
+constexpr const char *FrameStats::SUMMARY_FILE;
+constexpr const char *FrameStats::HISTOGRAM_FILE;
+
+// -------------------------------------------------------------------------------------------------
+
+FrameStats::FrameStats(void)
+{
+	Reset();
+}
+
+FrameStats::~FrameStats(void)
+{
+}
+
+void FrameStats::Reset(void)
+{
+	memset(m_buckets, 0, sizeof(m_buckets));
+
+	m_frameCount = 0;
+	m_framesOverBudget = 0;
+	m_peakEntityCount = 0;
+	m_totalFrameTime = 0;
+	m_maxFrameTime = 0;
+}
+
+void FrameStats::RecordFrame(float frameTime, uint32_t entityCount)
+{
+	++m_buckets[GetBucketIndex(frameTime)];
+	++m_frameCount;
+
+	m_totalFrameTime += frameTime;
+
+	if (frameTime > FRAME_BUDGET) {
+		++m_framesOverBudget;
+	}
+	if (frameTime > m_maxFrameTime) {
+		m_maxFrameTime = frameTime;
+	}
+	if (entityCount > m_peakEntityCount) {
+		m_peakEntityCount = entityCount;
+	}
+}
+
+float FrameStats::GetPercentile(float percentile) const
+{
+	if (m_frameCount == 0) {
+		return 0;
+	}
+
+	// Find the bucket which contains the frame at the requested rank and report its upper bound.
+	uint32_t rank = (uint32_t)ceilf(percentile * m_frameCount);
+	uint32_t frames = 0;
+
+	if (rank == 0) {
+		rank = 1;
+	}
+
+	for (uint32_t i = 0; i < NUM_BUCKETS; i++) {
+
+		frames += m_buckets[i];
+
+		if (frames >= rank) {
+
+			// The bucket boundary can't be more than the slowest frame that was actually recorded.
+			float bucketMax = GetBucketMax(i);
+			return (bucketMax < m_maxFrameTime ? bucketMax : m_maxFrameTime);
+		}
+	}
+
+	return m_maxFrameTime;
+}
+
+bool FrameStats::WriteReport(const char *label, uint32_t level) const
+{
+	FILE *summary = fopen(SUMMARY_FILE, "a");
+	FILE *histogram = fopen(HISTOGRAM_FILE, "a");
+
+	if (summary == nullptr || histogram == nullptr) {
+
+		if (summary != nullptr) fclose(summary);
+		if (histogram != nullptr) fclose(histogram);
+
+		return false;
+	}
+
+	// Rows of the same report are identified by the time the report was written.
+	char timestamp[32];
+	time_t now = time(nullptr);
+	strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+
+	// Write column headers into new files.
+	if (IsFileEmpty(summary)) {
+
+		fprintf(summary, "timestamp,report,level,frames,avg_ms,p50_ms,p95_ms,p99_ms,max_ms,"
+		                 "budget_ms,frames_over_budget,peak_entities\n");
+	}
+
+	if (IsFileEmpty(histogram)) {
+		fprintf(histogram, "timestamp,report,level,bucket_min_ms,bucket_max_ms,frames\n");
+	}
+
+	float average = (m_frameCount != 0 ? m_totalFrameTime / m_frameCount : 0);
+
+	fprintf(summary, "%s,%s,%u,%u,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%u,%u\n",
+		timestamp, label, level, m_frameCount,
+		1000 * average,
+		1000 * GetPercentile(0.50f),
+		1000 * GetPercentile(0.95f),
+		1000 * GetPercentile(0.99f),
+		1000 * m_maxFrameTime,
+		1000 * FRAME_BUDGET,
+		m_framesOverBudget,
+		m_peakEntityCount
+	);
+
+	// Only the non-empty part of the distribution is written to keep the files readable.
+	for (uint32_t i = 0; i < NUM_BUCKETS; i++) {
+
+		if (m_buckets[i] == 0) {
+			continue;
+		}
+
+		fprintf(histogram, "%s,%s,%u,%.3f,%.3f,%u\n",
+			timestamp, label, level, 1000 * GetBucketMin(i), 1000 * GetBucketMax(i), m_buckets[i]);
+	}
+
+	fclose(summary);
+	fclose(histogram);
+
+	return true;
+}
+
+uint32_t FrameStats::GetBucketIndex(float frameTime)
+{
+	if (frameTime < MIN_FRAME_TIME) {
+		return 0;
+	}
+
+	// frexpf splits the value into a mantissa in [0.5, 1) and a power of two, which gives us the
+	// octave without a logarithm. The mantissa then selects a linear sub-bucket within the octave.
+	int exponent;
+	float mantissa = frexpf(frameTime / MIN_FRAME_TIME, &exponent);
+
+	uint32_t octave = (uint32_t)(exponent - 1);
+
+	if (octave >= NUM_OCTAVES) {
+		return NUM_BUCKETS - 1;
+	}
+
+	uint32_t subBucket = (uint32_t)((2 * mantissa - 1) * BUCKETS_PER_OCTAVE);
+
+	if (subBucket >= BUCKETS_PER_OCTAVE) {
+		subBucket = BUCKETS_PER_OCTAVE - 1;
+	}
+
+	return octave * BUCKETS_PER_OCTAVE + subBucket;
+}
+
+float FrameStats::GetBucketMin(uint32_t bucket)
+{
+	uint32_t octave = bucket / BUCKETS_PER_OCTAVE;
+	uint32_t subBucket = bucket % BUCKETS_PER_OCTAVE;
+
+	return ldexpf(MIN_FRAME_TIME, octave) * (1 + (float)subBucket / BUCKETS_PER_OCTAVE);
+}
+
+float FrameStats::GetBucketMax(uint32_t bucket)
+{
+	uint32_t octave = bucket / BUCKETS_PER_OCTAVE;
+	uint32_t subBucket = bucket % BUCKETS_PER_OCTAVE;
+
+	return ldexpf(MIN_FRAME_TIME, octave) * (1 + (float)(subBucket + 1) / BUCKETS_PER_OCTAVE);
+}
+
+bool FrameStats::IsFileEmpty(FILE *file)
+{
+	// Files opened in append mode are positioned at the end.
+	fseek(file, 0, SEEK_END);
+	return (ftell(file) == 0);
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "gamedefs.h"
+#include <stdio.h>
+
+// -------------------------------------------------------------------------------------------------
+
+// Collects a frame time distribution into a fixed size logarithmic histogram. Each octave of frame
+// time (0.1-0.2ms, 0.2-0.4ms...) is split into a number of linear sub-buckets, which keeps the
+// relative error of the percentiles small while recording a frame is just an increment.
+class FrameStats
+{
+public:
+	FrameStats(void);
+	~FrameStats(void);
+
+	void Reset(void);
+	void RecordFrame(float frameTime, uint32_t entityCount);
+
+	uint32_t GetFrameCount(void) const { return m_frameCount; }
+	float GetPercentile(float percentile) const;
+
+	// Appends the summary and the histogram of the recorded frames to the report CSV files.
+	bool WriteReport(const char *label, uint32_t level) const;
+
+public:
+	static constexpr float FRAME_BUDGET = 1.0f / 60; // seconds
+
+private:
+	static uint32_t GetBucketIndex(float frameTime);
+	static float GetBucketMin(uint32_t bucket);
+	static float GetBucketMax(uint32_t bucket);
+
+	static bool IsFileEmpty(FILE *file);
+
+private:
+	static constexpr float MIN_FRAME_TIME = 0.0001f; // seconds
+	static constexpr uint32_t BUCKETS_PER_OCTAVE = 16;
+	static constexpr uint32_t NUM_OCTAVES = 15; // Up to ~3.3 seconds
+	static constexpr uint32_t NUM_BUCKETS = BUCKETS_PER_OCTAVE * NUM_OCTAVES;
+
+	static constexpr const char *SUMMARY_FILE = "frametimes.csv";
+	static constexpr const char *HISTOGRAM_FILE = "frametimes-histogram.csv";
+
+	uint32_t m_buckets[NUM_BUCKETS];
+
+	uint32_t m_frameCount = 0;
+	uint32_t m_framesOverBudget = 0;
+	uint32_t m_peakEntityCount = 0;
+	float m_totalFrameTime = 0;
+	float m_maxFrameTime = 0;
+};
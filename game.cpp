@@ -3,10 +3,17 @@
 #include "collisionhandler.h"
 #include "asteroidhandler.h"
 #include "utils.h"
+#include "autopilot.h"
+#include "soaktest.h"
+#include "benchmark.h"
 #include "gamescene.h"
 #include "menuscene.h"
 #include "ship.h"
 #include "ui.h"
+#include "framestats.h"
+#include "effectqualitycontroller.h"
+#include "perfcounters.h"
+#include "probes.h"
 #include "editor/editor.h"
 #include <mylly/core/mylly.h>
 #include <mylly/core/time.h>
@@ -24,6 +31,8 @@ Game::Game(void)
 	m_collisionHandler = new CollisionHandler();
 	m_input = new InputHandler(this);
 	m_ui = new UI();
+	m_frameStats = new FrameStats();
+	m_effectQuality = new EffectQualityController();
 	
 	// Create an editor system for testing.
 	m_editor = new Editor();
@@ -36,7 +45,17 @@ Game::~Game(void)
 		audio_stop_sound(m_musicInstance);
 	}
 
+	// Write the frame times of an unfinished level when exiting the game.
+	if (m_frameStats->GetFrameCount() != 0) {
+		m_frameStats->WriteReport("exit", m_currentLevel);
+	}
+
+	delete m_frameStats;
 	delete m_input;
+	delete m_autopilot;
+	delete m_soakTest;
+	delete m_effectQuality;
+	delete m_benchmark;
 	delete m_ui;
 	delete m_scene;
 	delete m_editor;
@@ -47,6 +66,9 @@ Game::~Game(void)
 		delete m_nextScene;
 	}
 
+	// The scenes are gone, release the shaders they cloned for shared sprites.
+	Scene::ReleaseClonedShaders();
+
 	delete m_collisionHandler;
 }
 
@@ -71,7 +93,7 @@ void Game::SetupGame(void)
 	ChangeScene();
 }
 
-void Game::StartNewGame(void)
+void Game::StartNewGame(uint32_t level)
 {
 	// Reset score and ships.
 	m_score = 0;
@@ -79,14 +101,14 @@ void Game::StartNewGame(void)
 	m_scoreSinceLastPowerUp = 0;
 	m_currentPowerUp = POWERUP_NONE;
 	m_ships = 3;
-	m_currentLevel = 1;
+	m_currentLevel = level;
 	m_isLevelCompleted = false;
 	m_isRespawning = false;
 
 	m_ui->SetScore(0);
 	m_ui->SetShipCount(3);
 
-	LoadLevel(1);
+	LoadLevel(level);
 }
 
 void Game::LoadLevel(uint32_t level)
@@ -108,9 +130,60 @@ void Game::LoadMainMenu(void)
 }
 
 void Game::Update(void)
+{
+	// Advance the game time used by the entities and effects.
+	Utils::UpdateTime();
+
+	// Measure the time spent in the game's own update when benchmarking.
+	if (m_benchmark != nullptr) {
+		m_benchmark->BeginUpdate();
+	}
+
+	UpdateGame();
+
+	if (m_benchmark != nullptr) {
+		m_benchmark->EndUpdate(this);
+	}
+}
+
+void Game::UpdateGame(void)
 {
 	m_editor->Process();
 
+	// Store the hot path counters of the previous frame. If the frame took longer than the budget,
+	// log the counters so the spike can be connected to what was happening in the game.
+	PerfCounters::NextFrame();
+
+	if (PerfCounters::IsLoggingSpikes() &&
+		get_time().real_delta_time > FrameStats::FRAME_BUDGET) {
+
+		PerfCounters::Dump(stdout, get_time().real_delta_time);
+	}
+
+	// The soak test loads levels and the main menu on its own. It is updated before the autopilot so
+	// it gets to start the next cycle before the autopilot would start a game from the menu.
+	if (m_soakTest != nullptr) {
+		m_soakTest->Update(this);
+	}
+
+	// Let the autopilot decide its controls before the ship reads them.
+	if (m_autopilot != nullptr) {
+		m_autopilot->Update(this);
+	}
+
+	// Collect frame time statistics while playing a level.
+	if (m_scene != nullptr &&
+		m_scene->GetType() == SCENE_GAME &&
+		!m_isLevelCompleted &&
+		!m_isPaused &&
+		!IsLoadingLevel()) {
+
+		m_frameStats->RecordFrame(get_time().real_delta_time, m_collisionHandler->GetEntityCount());
+	}
+
+	// Adjust the light and particle budgets to the measured frame time.
+	m_effectQuality->Update(this);
+
 	if (m_scene != nullptr) {
 		m_scene->Update(this);
 	}
@@ -174,7 +247,7 @@ object_t *Game::SpawnSceneObject(object_t *parent)
 		return nullptr;
 	}
 
-	return scene_create_object(m_scene->GetSceneRoot(), parent);
+	return Utils::CreateObject(m_scene->GetSceneRoot(), parent);
 }
 
 bool Game::IsWithinBoundaries(const Vec2 &position) const
@@ -187,6 +260,16 @@ bool Game::IsWithinBoundaries(const Vec2 &position) const
 	);
 }
 
+bool Game::IsInView(const Vec2 &position, float radius) const
+{
+	return (
+		position.x() + radius > m_viewMin.x() &&
+		position.x() - radius < m_viewMax.x() &&
+		position.y() + radius > m_viewMin.y() &&
+		position.y() - radius < m_viewMax.y()
+	);
+}
+
 Vec2 Game::WrapBoundaries(const Vec2 &position) const
 {
 	Vec2 wrapped = position;
@@ -224,8 +307,11 @@ void Game::ChangeScene(void)
 	// Initialize the next scene.
 	m_scene = m_nextScene;
 
+	GAME_PROBE2(change_scene, (int)m_scene->GetType(), m_currentLevel);
+
 	m_scene->Create(this);
 	m_scene->CalculateBoundaries(m_boundsMin, m_boundsMax);
+	m_scene->CalculateBoundaries(m_viewMin, m_viewMax, 0);
 
 	// Start the game.
 	m_scene->SetupLevel(this);
@@ -236,6 +322,15 @@ void Game::ChangeScene(void)
 	m_ui->SetScore(m_score);
 	m_isLevelCompleted = false;
 
+	// Report the frame times of a level which was left before it was completed (game over or
+	// returning to the main menu), then start collecting from the beginning of the new scene.
+	if (m_frameStats->GetFrameCount() != 0) {
+		m_frameStats->WriteReport("aborted", m_currentLevel);
+	}
+
+	m_frameStats->Reset();
+	m_effectQuality->OnSceneChanged();
+
 	m_nextScene = nullptr;
 
 	if (previousSceneType != m_scene->GetType()) {
@@ -246,11 +341,11 @@ void Game::ChangeScene(void)
 		switch (m_scene->GetType()) {
 
 			case SCENE_GAME:
-				m_musicInstance = audio_play_sound(res_get_sound("Game"), 1);
+				m_musicInstance = Utils::PlaySound("Game", 1);
 				break;
 
 			default:
-				m_musicInstance = audio_play_sound(res_get_sound("Menu"), 1);
+				m_musicInstance = Utils::PlaySound("Menu", 1);
 				break;
 		}
 
@@ -286,6 +381,10 @@ float Game::GetDifficultyMultiplier(void) const
 void Game::OnLevelCompleted(void)
 {
 	m_isLevelCompleted = true;
+
+	// Write a frame time report for QA and start collecting the next level from scratch.
+	m_frameStats->WriteReport("level", m_currentLevel);
+	m_frameStats->Reset();
 }
 
 void Game::OnShipDestroyed(void)
@@ -344,8 +443,8 @@ void Game::OnPowerUpCollected(void)
 	m_scoreSinceLastPowerUp = 0;
 
 	// Play a powerup sound effect.
-	audio_play_sound(res_get_sound("Powerup"), 0);
-	audio_play_sound(res_get_sound("Reload"), 0);
+	Utils::PlaySound("Powerup", 0);
+	Utils::PlaySound("Reload", 0);
 
 	switch (m_currentPowerUp) {
 
@@ -363,6 +462,48 @@ void Game::OnPowerUpCollected(void)
 	}
 }
 
+void Game::EnableAutopilot(void)
+{
+	if (m_autopilot != nullptr) {
+		return;
+	}
+
+	m_autopilot = new Autopilot();
+	m_input->SetAutopilot(m_autopilot);
+}
+
+void Game::EnableBenchmark(uint32_t level, float duration)
+{
+	if (m_benchmark != nullptr) {
+		return;
+	}
+
+	m_benchmark = new Benchmark(level, duration);
+
+	// Make the runs as repeatable as possible: the autopilot plays the level with a fixed time step,
+	// at a fixed quality level and without random camera shake. The benchmark fixes the random
+	// seed itself.
+	Utils::SetFixedTimeStep(Benchmark::TIME_STEP);
+	Scene::SetShakeEnabled(false);
+
+	m_effectQuality->SetQualityLevel(0);
+	m_effectQuality->SetEnabled(false);
+
+	EnableAutopilot();
+}
+
+void Game::EnableSoakTest(uint32_t cycles, float playDuration)
+{
+	if (m_soakTest != nullptr) {
+		return;
+	}
+
+	m_soakTest = new SoakTest(cycles, playDuration);
+
+	// The levels are played by the autopilot.
+	EnableAutopilot();
+}
+
 void Game::TogglePause(void)
 {
 	// Allow pausing in the game but not in the main menu.
@@ -377,3 +518,11 @@ void Game::TogglePause(void)
 	m_ui->TogglePauseMenu(m_isPaused);
 	input_toggle_cursor(m_isPaused);
 }
+
+void Game::Exit(int exitCode)
+{
+	// Shut down through the engine so the scenes are cleaned up normally, the exit code is
+	// returned from main() afterwards.
+	m_exitCode = exitCode;
+	mylly_exit();
+}
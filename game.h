@@ -31,11 +31,12 @@ public:
 	InputHandler *GetInputHandler(void) const { return m_input; }
 	UI *GetUI(void) const { return m_ui; }
 	Scene *GetScene(void) const { return m_scene; }
+	EffectQualityController *GetEffectQualityController(void) const { return m_effectQuality; }
 
 	void SetupGame(void);
 	bool IsSetup(void) const { return (m_scene != nullptr); }
 
-	void StartNewGame(void);
+	void StartNewGame(uint32_t level = 1);
 	void LoadLevel(uint32_t level);
 	void LoadMainMenu(void);
 	void ChangeScene(void);
@@ -48,6 +49,7 @@ public:
 	Vec2 GetBoundsMin(void) const { return m_boundsMin; }
 	Vec2 GetBoundsMax(void) const { return m_boundsMax; }
 	Vec2 WrapBoundaries(const Vec2 &position) const;
+	bool IsInView(const Vec2 &position, float radius) const;
 
 	uint32_t GetLevel(void) const { return m_currentLevel; }
 	uint32_t GetScore(void) const { return m_score; }
@@ -71,9 +73,21 @@ public:
 
 	bool IsLoadingLevel(void) const { return (m_nextScene != nullptr); }
 
+	void EnableAutopilot(void);
+	bool IsAutopilotEnabled(void) const { return (m_autopilot != nullptr); }
+
+	void EnableSoakTest(uint32_t cycles, float playDuration);
+	void EnableBenchmark(uint32_t level, float duration);
+
 	void TogglePause(void);
 	bool IsPaused(void) const { return m_isPaused; }
 
+	void Exit(int exitCode);
+	int GetExitCode(void) const { return m_exitCode; }
+
+private:
+	void UpdateGame(void);
+
 private:
 	InputHandler *m_input = nullptr;
 	CollisionHandler *m_collisionHandler = nullptr;
@@ -83,6 +97,8 @@ private:
 
 	Vec2 m_boundsMin = Vec2();
 	Vec2 m_boundsMax = Vec2();
+	Vec2 m_viewMin = Vec2(); // Area visible to the camera
+	Vec2 m_viewMax = Vec2();
 
 	uint32_t m_currentLevel = 1;
 	uint32_t m_score = 0;
@@ -97,6 +113,13 @@ private:
 	PowerUpType m_currentPowerUp = POWERUP_NONE;
 
 	Editor *m_editor = nullptr;
+	FrameStats *m_frameStats = nullptr;
+	Autopilot *m_autopilot = nullptr;
+	SoakTest *m_soakTest = nullptr;
+	EffectQualityController *m_effectQuality = nullptr;
+	Benchmark *m_benchmark = nullptr;
 
 	sound_instance_t m_musicInstance = 0;
+
+	int m_exitCode = 0; // Returned from main() after the engine has shut down
 };
@@ -4,15 +4,22 @@
 
 class Asteroid;
 class AsteroidHandler;
+class Autopilot;
+class Benchmark;
 class CollisionHandler;
+class EffectHandler;
+class EffectQualityController;
 class Entity;
+class FrameStats;
 class Game;
 class InputHandler;
+class LightHandler;
 class PowerUp;
 class Projectile;
 class ProjectileHandler;
 class Scene;
 class Ship;
+class SoakTest;
 class Ufo;
 class UI;
 class WarpEffect;
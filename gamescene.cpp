@@ -8,7 +8,6 @@
 #include "asteroidhandler.h"
 #include "projectilehandler.h"
 #include "inputhandler.h"
-#include <mylly/core/time.h>
 #include <mylly/resources/resources.h>
 #include <mylly/audio/audiosystem.h>
 
@@ -58,13 +57,13 @@ void GameScene::SetupLevel(Game *game)
 	game->GetUI()->ShowLevelLabel(game->GetLevel());
 
 	// Spawn the player's ship into the scene after a small delay.
-	m_playerShipSpawnTime = get_time().time + 1;
+	m_playerShipSpawnTime = Utils::GetTime() + 1;
 }
 
 void GameScene::Update(Game *game)
 {
 	if (m_playerShipSpawnTime != 0 &&
-		get_time().time >= m_playerShipSpawnTime) {
+		Utils::GetTime() >= m_playerShipSpawnTime) {
 
 		// Create the player's ship.
 		m_ship = new Ship();
@@ -105,7 +104,7 @@ void GameScene::Update(Game *game)
 			ShakeCamera(1.0f, 0.5f);
 
 			// Play an explosion sound effect.
-			audio_play_sound(res_get_sound("Explosion"), 0);
+			Utils::PlaySound("Explosion", 0);
 
 			// Remove the ship from the game.
 			m_ship->Destroy(game);
@@ -142,7 +141,7 @@ void GameScene::Update(Game *game)
 			ShakeCamera(0.5f, 0.3f);
 
 			// Play an explosion sound effect.
-			audio_play_sound(res_get_sound("Explosion"), 0);
+			Utils::PlaySound("Explosion", 0);
 
 			// Remove the UFO from the game.
 			m_ufo->Destroy(game);
@@ -180,10 +179,12 @@ void GameScene::Update(Game *game)
 		m_asteroids->DestroyAllAsteroids(game);
 	}
 
-	// Complete the level when all asteroids and the UFO have been destroyed.
+	// Complete the level when all asteroids and the UFO have been destroyed. The scene keeps
+	// updating while the next level is being loaded, don't complete it again then.
 	if (m_asteroids->AllAsteroidsDestroyed() &&
 		m_ufo == nullptr &&
-		!game->IsLevelCompleted()) {
+		!game->IsLevelCompleted() &&
+		!game->IsLoadingLevel()) {
 
 		game->OnLevelCompleted();
 		game->GetUI()->ShowLevelCompletedLabel();
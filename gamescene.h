@@ -17,6 +17,7 @@ public:
 	void RespawnShip(Game *game);
 
 	Ship *GetPlayerShip(void) const { return m_ship; }
+	Ufo *GetUfo(void) const { return m_ufo; }
 
 	virtual void OnEntityDestroyed(Game *game, Entity *entity) override;
 
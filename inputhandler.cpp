@@ -1,5 +1,7 @@
 #include "inputhandler.h"
 #include "game.h"
+#include "autopilot.h"
+#include "perfcounters.h"
 #include "editor/editor.h"
 #include <mylly/core/mylly.h>
 #include <mylly/io/input.h>
@@ -23,6 +25,7 @@ InputHandler::InputHandler(Game *game)
 	input_bind_key(MKEY_ESCAPE, TogglePause, game);
 	input_bind_key(MKEY_F9, ShowEditor, game);
 	input_bind_key(MKEY_F5, ToggleOverrideRenderBuffer, nullptr);
+	input_bind_key(MKEY_F6, TogglePerfCounterLog, nullptr);
 }
 
 InputHandler::~InputHandler(void)
@@ -31,6 +34,10 @@ InputHandler::~InputHandler(void)
 
 float InputHandler::GetSteering(void) const
 {
+	if (m_autopilot != nullptr) {
+		return m_autopilot->GetSteering();
+	}
+
 	float direction = 0;
 	
 	if (input_is_button_down(BUTTON_LEFT)) {
@@ -45,16 +52,28 @@ float InputHandler::GetSteering(void) const
 
 float InputHandler::GetAcceleration(void) const
 {
+	if (m_autopilot != nullptr) {
+		return m_autopilot->GetAcceleration();
+	}
+
 	return (input_is_button_down(BUTTON_FORWARD) ? 1 : 0);
 }
 
 bool InputHandler::IsFiring(void) const
 {
+	if (m_autopilot != nullptr) {
+		return m_autopilot->IsFiring();
+	}
+
 	return input_is_button_down(BUTTON_FIRE);
 }
 
 bool InputHandler::IsPressingConfirm(void) const
 {
+	if (m_autopilot != nullptr) {
+		return m_autopilot->IsPressingConfirm();
+	}
+
 	return input_is_button_down(BUTTON_CONFIRM);
 }
 
@@ -111,3 +130,18 @@ bool InputHandler::ToggleOverrideRenderBuffer(uint32_t key, bool pressed, void *
 
 	return true;
 }
+
+bool InputHandler::TogglePerfCounterLog(uint32_t key, bool pressed, void *context)
+{
+	UNUSED(key);
+	UNUSED(context);
+
+	if (pressed) {
+
+		// Print the counters of the current frame and start/stop logging frames over budget.
+		PerfCounters::Dump(stdout);
+		PerfCounters::ToggleSpikeLogging();
+	}
+
+	return true;
+}
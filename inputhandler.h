@@ -31,8 +31,15 @@ public:
 	bool IsPressingConfirm(void) const;
 	bool IsPressingGodmodeButton(void) const;
 
+	// When an autopilot is set, the player's controls are read from it instead of the keyboard.
+	void SetAutopilot(Autopilot *autopilot) { m_autopilot = autopilot; }
+
 private:
 	static bool TogglePause(uint32_t key, bool pressed, void *context);
 	static bool ShowEditor(uint32_t key, bool pressed, void *context);
 	static bool ToggleOverrideRenderBuffer(uint32_t key, bool pressed, void *context);
+	static bool TogglePerfCounterLog(uint32_t key, bool pressed, void *context);
+
+private:
+	Autopilot *m_autopilot = nullptr;
 };
@@ -0,0 +1,118 @@
+#include "lighthandler.h"
+#include "utils.h"
+#include <mylly/scene/scene.h>
+#include <mylly/scene/object.h>
+#include <mylly/scene/light.h>
+
+// -------------------------------------------------------------------------------------------------
+
+LightHandler::LightHandler(scene_t *sceneRoot)
+{
+	// Create a pool of point lights which are reused for every light request.
+	for (uint32_t i = 0; i < MAX_LIGHTS; i++) {
+
+		m_lightObjects[i] = Utils::CreateObject(sceneRoot);
+		m_lights[i] = obj_add_light(m_lightObjects[i]);
+
+		light_set_type(m_lights[i], LIGHT_POINT);
+
+		// Lights are enabled when a request is assigned to them.
+		obj_set_active(m_lightObjects[i], false);
+	}
+}
+
+LightHandler::~LightHandler(void)
+{
+	for (uint32_t i = 0; i < MAX_LIGHTS; i++) {
+		obj_destroy(m_lightObjects[i]);
+	}
+}
+
+void LightHandler::AddLight(const Vec2 &position, const colour_t &colour, float intensity, float range)
+{
+	// Requests over the limit are dropped. This is only to protect against extreme cases, the
+	// requests are ranked and most of them will not get a light anyway.
+	if (m_requestCount >= MAX_REQUESTS ||
+		intensity <= 0) {
+
+		return;
+	}
+
+	LightRequest &request = m_requests[m_requestCount++];
+
+	request.position = position;
+	request.colour = colour;
+	request.intensity = intensity;
+	request.range = range;
+	request.priority = 0;
+}
+
+void LightHandler::Update(const Vec2 &viewCenter)
+{
+	// Rank the requests. Bright lights near the center of the view are the most visible ones,
+	// lights far away (compared to their range) matter less.
+	for (uint32_t i = 0; i < m_requestCount; i++) {
+
+		LightRequest &request = m_requests[i];
+
+		Vec2 offset = request.position - viewCenter;
+		float distanceSquared = offset.Dot(offset);
+
+		request.priority = request.intensity / (1 + distanceSquared / (request.range * request.range));
+	}
+
+	// Move the most important requests to the beginning of the list. The budget is small so
+	// a partial selection sort is all we need.
+	uint32_t lightCount = (m_requestCount < m_maxLights ? m_requestCount : m_maxLights);
+
+	for (uint32_t i = 0; i < lightCount; i++) {
+
+		uint32_t best = i;
+
+		for (uint32_t j = i + 1; j < m_requestCount; j++) {
+
+			if (m_requests[j].priority > m_requests[best].priority) {
+				best = j;
+			}
+		}
+
+		if (best != i) {
+
+			LightRequest temp = m_requests[i];
+			m_requests[i] = m_requests[best];
+			m_requests[best] = temp;
+		}
+	}
+
+	// Assign the selected requests to the pooled lights and turn off the rest of the pool.
+	for (uint32_t i = 0; i < MAX_LIGHTS; i++) {
+
+		if (i < lightCount) {
+
+			const LightRequest &request = m_requests[i];
+
+			obj_set_position(m_lightObjects[i], vec3(request.position.x(), 0, request.position.y()));
+
+			light_set_colour(m_lights[i], request.colour);
+			light_set_intensity(m_lights[i], request.intensity);
+			light_set_range(m_lights[i], request.range);
+		}
+
+		bool wasActive = (i < m_activeLights);
+		bool isActive = (i < lightCount);
+
+		if (wasActive != isActive) {
+			obj_set_active(m_lightObjects[i], isActive);
+		}
+	}
+
+	m_activeLights = lightCount;
+
+	// Lights are requested again on the next frame.
+	m_requestCount = 0;
+}
+
+void LightHandler::SetMaxLights(uint32_t maxLights)
+{
+	m_maxLights = (maxLights < MAX_LIGHTS ? maxLights : MAX_LIGHTS);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "gamedefs.h"
+#include "vector.h"
+#include <mylly/renderer/colour.h>
+
+// -------------------------------------------------------------------------------------------------
+
+struct LightRequest {
+	Vec2 position;
+	colour_t colour;
+	float intensity;
+	float range;
+	float priority;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+// Keeps the number of point lights in the scene within a fixed budget. Instead of owning lights,
+// projectiles and light flashes request a light each frame. The handler ranks the requests by
+// intensity and distance from the camera and assigns the most important ones to a pool of
+// reusable point lights, so the cost of the lighting pass stays bounded no matter how many
+// lights the gameplay asks for.
+class LightHandler
+{
+public:
+	LightHandler(scene_t *sceneRoot);
+	~LightHandler(void);
+
+	void AddLight(const Vec2 &position, const colour_t &colour, float intensity, float range);
+	void Update(const Vec2 &viewCenter);
+
+	uint32_t GetMaxLights(void) const { return m_maxLights; }
+	void SetMaxLights(uint32_t maxLights);
+
+	uint32_t GetActiveLightCount(void) const { return m_activeLights; }
+
+public:
+	static constexpr uint32_t MAX_LIGHTS = 16; // Size of the light pool
+	static constexpr uint32_t MAX_REQUESTS = 256; // Max light requests per frame
+
+private:
+	object_t *m_lightObjects[MAX_LIGHTS];
+	light_t *m_lights[MAX_LIGHTS];
+
+	uint32_t m_maxLights = MAX_LIGHTS; // Current light budget
+	uint32_t m_activeLights = 0;
+
+	LightRequest m_requests[MAX_REQUESTS];
+	uint32_t m_requestCount = 0;
+};
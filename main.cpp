@@ -1,18 +1,32 @@
 #include "game.h"
+#include "probes.h"
 #include <string.h>
+#include <stdlib.h>
 #include <mylly/core/mylly.h>
 
 // Game handler instance.
 static Game *game;
 
+// Exit code set by the game, e.g. when a soak test fails.
+static int exitCode = EXIT_SUCCESS;
+
 // This method is called on every frame before rendering the scene.
 static void MainLoop(void)
 {
+	static uint32_t frame = 0;
+
+	GAME_PROBE1(frame_start, frame);
+
 	game->Update();
+
+	GAME_PROBE1(frame_end, frame);
+	++frame;
 }
 
 static void Cleanup(void)
 {
+	exitCode = game->GetExitCode();
+
 	delete game;
 	game = nullptr;
 }
@@ -21,6 +35,39 @@ int main(int argc, char **argv)
 {
 	game = new Game();
 
+	// Parse the game's own command line options.
+	uint32_t soakCycles = 0;
+	float soakPlayDuration = 10.0f;
+	float benchmarkDuration = 0;
+	uint32_t benchmarkLevel = 1;
+
+	for (int i = 1; i < argc; i++) {
+
+		if (strcmp(argv[i], "--autopilot") == 0) {
+			game->EnableAutopilot();
+		}
+		else if (strcmp(argv[i], "--soak") == 0 && i + 1 < argc) {
+			soakCycles = (uint32_t)atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--soak-play") == 0 && i + 1 < argc) {
+			soakPlayDuration = (float)atof(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--benchmark") == 0 && i + 1 < argc) {
+			benchmarkDuration = (float)atof(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--benchmark-level") == 0 && i + 1 < argc) {
+			benchmarkLevel = (uint32_t)atoi(argv[++i]);
+		}
+	}
+
+	if (benchmarkDuration > 0) {
+		game->EnableBenchmark(benchmarkLevel, benchmarkDuration);
+	}
+
+	if (soakCycles != 0) {
+		game->EnableSoakTest(soakCycles, soakPlayDuration);
+	}
+
 	mylly_params_t params;
 	memset(&params, 0, sizeof(params));
 
@@ -37,5 +84,5 @@ int main(int argc, char **argv)
 		mylly_main_loop();
 	}
 
-	return 0;
+	return exitCode;
 }
@@ -0,0 +1,59 @@
+#include "perfcounters.h"
+
+// -------------------------------------------------------------------------------------------------
+
+static const char *counterNames[NUM_PERF_COUNTERS] = {
+	"collision_pairs",
+	"collision_contacts",
+	"collision_responses",
+	"effects_spawned",
+	"effects_throttled",
+	"light_flashes",
+	"sounds_started",
+	"objects_created",
+};
+
+std::atomic<uint32_t> PerfCounters::s_counters[NUM_PERF_COUNTERS];
+uint32_t PerfCounters::s_lastFrame[NUM_PERF_COUNTERS];
+uint32_t PerfCounters::s_frameNumber = 0;
+bool PerfCounters::s_isLoggingSpikes = false;
+
+// -------------------------------------------------------------------------------------------------
+
+void PerfCounters::NextFrame(void)
+{
+	for (uint32_t i = 0; i < NUM_PERF_COUNTERS; i++) {
+		s_lastFrame[i] = s_counters[i].exchange(0, std::memory_order_relaxed);
+	}
+
+	++s_frameNumber;
+}
+
+const char *PerfCounters::GetName(PerfCounter counter)
+{
+	if (counter >= NUM_PERF_COUNTERS) {
+		return "";
+	}
+
+	return counterNames[counter];
+}
+
+void PerfCounters::Dump(FILE *file, float frameTime)
+{
+	if (file == nullptr) {
+		return;
+	}
+
+	fprintf(file, "frame %u", s_frameNumber);
+
+	if (frameTime > 0) {
+		fprintf(file, " (%.2f ms)", 1000 * frameTime);
+	}
+
+	for (uint32_t i = 0; i < NUM_PERF_COUNTERS; i++) {
+		fprintf(file, " %s=%u", counterNames[i], s_lastFrame[i]);
+	}
+
+	fprintf(file, "\n");
+	fflush(file);
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "gamedefs.h"
+#include <stdio.h>
+#include <atomic>
+
+// -------------------------------------------------------------------------------------------------
+
+enum PerfCounter {
+
+	COUNTER_COLLISION_PAIRS, // Entity pairs tested for collision
+	COUNTER_COLLISION_CONTACTS, // Entity pairs found colliding
+	COUNTER_COLLISION_RESPONSES, // Collision responses applied
+	COUNTER_EFFECTS_SPAWNED, // Particle emitters spawned by Scene::SpawnEffect
+	COUNTER_EFFECTS_THROTTLED, // Effect spawns dropped by the effect rate limiter
+	COUNTER_LIGHT_FLASHES, // Light flashes alive at the end of the frame
+	COUNTER_SOUNDS_STARTED, // Sound instances started
+	COUNTER_OBJECTS_CREATED, // Scene objects created
+
+	NUM_PERF_COUNTERS
+};
+
+// -------------------------------------------------------------------------------------------------
+
+// Per-frame counters for the hot paths of the game. Incrementing a counter is a single relaxed
+// atomic add so they can be left in release builds and used from any thread.
+class PerfCounters
+{
+public:
+	static void Increment(PerfCounter counter, uint32_t amount = 1) {
+		s_counters[counter].fetch_add(amount, std::memory_order_relaxed);
+	}
+
+	static void Set(PerfCounter counter, uint32_t value) {
+		s_counters[counter].store(value, std::memory_order_relaxed);
+	}
+
+	// Stores the values of the frame that just ended and resets the counters for the next one.
+	static void NextFrame(void);
+
+	// Values of the last completed frame.
+	static uint32_t GetValue(PerfCounter counter) { return s_lastFrame[counter]; }
+	static uint32_t GetFrameNumber(void) { return s_frameNumber; }
+	static const char *GetName(PerfCounter counter);
+
+	// Writes the values of the last completed frame as a single line of text.
+	static void Dump(FILE *file, float frameTime = 0);
+
+	static void ToggleSpikeLogging(void) { s_isLoggingSpikes = !s_isLoggingSpikes; }
+	static bool IsLoggingSpikes(void) { return s_isLoggingSpikes; }
+
+private:
+	static std::atomic<uint32_t> s_counters[NUM_PERF_COUNTERS];
+	static uint32_t s_lastFrame[NUM_PERF_COUNTERS];
+	static uint32_t s_frameNumber;
+	static bool s_isLoggingSpikes;
+};
@@ -0,0 +1,25 @@
+#pragma once
+
+// -------------------------------------------------------------------------------------------------
+
+// Static tracing probes (USDT) for Linux perf and bpftrace, e.g.
+//
+// bpftrace -e 'usdt:./game:game:frame_end { @frames = count(); }'
+//
+// A probe compiles to a single nop instruction and only costs something while a tracer is
+// attached to it. Probes are enabled with the USE_USDT_PROBES CMake option.
+#if defined(USE_USDT_PROBES)
+
+#include <sys/sdt.h>
+
+#define GAME_PROBE(name) DTRACE_PROBE(game, name)
+#define GAME_PROBE1(name, arg1) DTRACE_PROBE1(game, name, arg1)
+#define GAME_PROBE2(name, arg1, arg2) DTRACE_PROBE2(game, name, arg1, arg2)
+
+#else
+
+#define GAME_PROBE(name)
+#define GAME_PROBE1(name, arg1)
+#define GAME_PROBE2(name, arg1, arg2)
+
+#endif
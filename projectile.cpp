@@ -1,11 +1,11 @@
 #include "projectile.h"
 #include "projectilehandler.h"
 #include "game.h"
+#include "lighthandler.h"
+#include "utils.h"
 #include <mylly/scene/object.h>
-#include <mylly/scene/light.h>
 #include <mylly/scene/emitter.h>
 #include <mylly/resources/resources.h>
-#include <mylly/core/time.h>
 #include <mylly/math/math.h>
 
 // -------------------------------------------------------------------------------------------------
@@ -42,31 +42,32 @@ void Projectile::Spawn(Game *game)
 	SetSceneObject(game->SpawnSceneObject());
 	obj_set_sprite(GetSceneObject(), bulletSprite);
 
+	m_sprite = bulletSprite;
+
 	// Rotate the sprite towards the camera.
 	obj_set_local_rotation(GetSceneObject(), quat_from_euler_deg(90, 0, 0));
-	obj_set_local_scale(GetSceneObject(), vec3(0.15f, 0.15f, 0.15f));
-
-	// Add a light component to the projectile so it lights the asteroids it hits.
-	light_t *light = obj_add_light(GetSceneObject());
-
-	light_set_type(light, LIGHT_POINT);
-	light_set_range(light, 10.0f);
-	light_set_intensity(light, 3);
+	obj_set_local_scale(GetSceneObject(), vec3(SPRITE_SCALE, SPRITE_SCALE, SPRITE_SCALE));
 
-	// Attach a particle emitter to the projectile for a trail effect.
+	// Attach a particle emitter to the projectile for a trail effect. The projectile also emits
+	// a light so it lights the asteroids it hits.
 	if (IsOwnedByPlayer()) {
 
 		m_trailEmitter = game->GetScene()->SpawnEffect("projectile-trail", GetPosition());
-		light_set_colour(light, col(100, 150, 200));
+		m_lightColour = col(100, 150, 200);
 	}
 	else {
 
 		m_trailEmitter = game->GetScene()->SpawnEffect("projectile2-trail", GetPosition());
-		light_set_colour(light, col(200, 100, 150));
+		m_lightColour = col(200, 100, 150);
 	}
 
+	// Attach the trail to the projectile so it follows the projectile without manual updates.
+	// The object is rotated towards the camera like the effect already is, and the scale of
+	// the sprite is cancelled out.
+	AttachEmitter(m_trailEmitter, vec3(0, 0, 0), quat_from_euler_deg(0, 0, 0), 1.0f / SPRITE_SCALE);
+
 	// Projectiles are automatically destroyed after a while if they don't hit anything.
-	m_expiresTime = get_time().time + (IsOwnedByPlayer() ? PLAYER_LIFETIME : UFO_LIFETIME);
+	m_expiresTime = Utils::GetTime() + (IsOwnedByPlayer() ? PLAYER_LIFETIME : UFO_LIFETIME);
 }
 
 void Projectile::Destroy(Game *game)
@@ -77,9 +78,10 @@ void Projectile::Destroy(Game *game)
 
 	game->GetScene()->GetProjectileHandler()->RemoveReference(this);
 
-	// Stop trail particle emitter. The effect is automatically destroyed when it no longer has
-	// active particles.
-	emitter_stop(m_trailEmitter);
+	// Detach and stop the trail particle emitter. The effect is automatically destroyed when it
+	// no longer has active particles.
+	DetachEmitter(m_trailEmitter, GetScenePosition().vec(), quat_from_euler_deg(90, 0, 0));
+	m_trailEmitter = nullptr;
 
 	// Do final cleanup.
 	Entity::Destroy(game);
@@ -92,21 +94,46 @@ void Projectile::Update(Game *game)
 	}
 
 	// Move the projectile.
-	Vec2 movement = GetVelocity() * get_time().delta_time;
+	Vec2 movement = GetVelocity() * Utils::GetDeltaTime();
 	SetPosition(GetPosition() + movement);
 
 	Entity::Update(game);
 
 	// Destroy the projectile if it has hit something (an asteroid) or has been flying for a while.
 	if (IsDestroyed() ||
-		get_time().time >= m_expiresTime) {
+		Utils::GetTime() >= m_expiresTime) {
 
+		// The projectile no longer exists after this.
 		Destroy(game);
+		return;
 	}
 
-	// Update trail emitter position in the scene.
-	if (m_trailEmitter != nullptr) {
-		obj_set_position(m_trailEmitter->parent, GetScenePosition().vec());
+	// Request a light from the scene's light budget.
+	game->GetScene()->GetLightHandler()->AddLight(GetPosition(), m_lightColour,
+	                                              LIGHT_INTENSITY, LIGHT_RANGE);
+}
+
+void Projectile::SetVisualsActive(bool isActive)
+{
+	// Only remove the sprite, the trail is a child of the same object and its particles should
+	// fade out normally.
+	obj_set_sprite(GetSceneObject(), isActive ? m_sprite : nullptr);
+}
+
+void Projectile::OnVisibilityChanged(Game *game, bool isVisible)
+{
+	UNUSED(game);
+
+	if (m_trailEmitter == nullptr) {
+		return;
+	}
+
+	// Don't leave a trail behind at the edge of the view while the projectile is outside of it.
+	if (isVisible) {
+		emitter_start(m_trailEmitter);
+	}
+	else {
+		emitter_stop(m_trailEmitter);
 	}
 }
 
@@ -122,7 +149,8 @@ void Projectile::OnCollideWith(const Game *game, Entity *other)
 
 		// Spawn a hit effect.
 		game->GetScene()->SpawnEffect(
-			IsOwnedByPlayer() ? "projectile-hit" : "projectile2-hit", GetPosition()
+			IsOwnedByPlayer() ? "projectile-hit" : "projectile2-hit", GetPosition(),
+			GetBoundingRadius()
 		);
 	}
 }
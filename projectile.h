@@ -1,6 +1,7 @@
 #pragma once
 
 #include "entity.h"
+#include <mylly/renderer/colour.h>
 
 // -------------------------------------------------------------------------------------------------
 
@@ -25,8 +26,18 @@ public:
 
 	virtual void OnCollideWith(const Game *game, Entity *other) override;
 
-private:
+protected:
+	virtual void SetVisualsActive(bool isActive) override;
+	virtual void OnVisibilityChanged(Game *game, bool isVisible) override;
+
+public:
 	static constexpr float PLAYER_SPEED = 25.0f; // Units/Sec
+
+private:
+	static constexpr float SPRITE_SCALE = 0.15f;
+	static constexpr float LIGHT_INTENSITY = 3.0f;
+	static constexpr float LIGHT_RANGE = 10.0f; // Units
+
 	static constexpr float PLAYER_LIFETIME = 1.0f; // Seconds
 
 	static constexpr float UFO_SPEED = 12.0f; // Units/Sec
@@ -35,5 +46,7 @@ private:
 	Entity *m_owner = nullptr; // Entity which fired the projectile
 	float m_expiresTime = 0; // Time when the projectile should self-destruct
 
+	sprite_t *m_sprite = nullptr; // Bullet sprite, removed from the object outside the view
 	emitter_t *m_trailEmitter = nullptr; // Projectile trail particle emitter
+	colour_t m_lightColour = COL_WHITE; // Colour of the light the projectile emits
 };
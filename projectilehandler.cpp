@@ -1,6 +1,7 @@
 #include "projectilehandler.h"
 #include "projectile.h"
 #include "game.h"
+#include "probes.h"
 
 // -------------------------------------------------------------------------------------------------
 
@@ -27,6 +28,8 @@ Projectile *ProjectileHandler::FireProjectile(Game *game, Entity *entity,
 		return nullptr;
 	}
 
+	GAME_PROBE2(fire_projectile, (int)entity->GetType(), m_projectiles.count);
+
 	Projectile *projectile = new Projectile();
 	projectile->SetOwner(entity);
 	projectile->Spawn(game);
@@ -3,7 +3,7 @@
 	emitter: {
 		sprite: "flash04",
 		is_world_space: true,
-		max_particles: 500,
+		max_particles: 10,
 		emit_duration: 0.000,
 		emit_rate: 0.000,
 		initial_burst: 10,
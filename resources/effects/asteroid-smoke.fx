@@ -3,7 +3,7 @@
 	emitter: {
 		sprite: "blackSmoke22",
 		is_world_space: true,
-		max_particles: 500,
+		max_particles: 100,
 		emit_duration: 0.000,
 		emit_rate: 0.000,
 		initial_burst: 100,
@@ -3,7 +3,7 @@
 	emitter: {
 		sprite: "whitePuff06",
 		is_world_space: true,
-		max_particles: 1000,
+		max_particles: 330,
 		emit_duration: 0.000,
 		emit_rate: 500.000,
 		initial_burst: 0,
@@ -3,7 +3,7 @@
 	emitter: {
 		sprite: "blackSmoke22",
 		is_world_space: true,
-		max_particles: 500,
+		max_particles: 195,
 		emit_duration: 0.750,
 		emit_rate: 100.000,
 		initial_burst: 100,
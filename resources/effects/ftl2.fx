@@ -3,7 +3,7 @@
 	emitter: {
 		sprite: "whitePuff06",
 		is_world_space: true,
-		max_particles: 1000,
+		max_particles: 290,
 		emit_duration: 0.300,
 		emit_rate: 200.000,
 		initial_burst: 200,
@@ -3,7 +3,7 @@
 	emitter: {
 		sprite: "gloweffect/4",
 		is_world_space: true,
-		max_particles: 1000,
+		max_particles: 195,
 		emit_duration: 0.000,
 		emit_rate: 175.000,
 		initial_burst: 0,
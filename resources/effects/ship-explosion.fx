@@ -3,7 +3,7 @@
 	emitter: {
 		sprite: "explosion_atlas/1",
 		is_world_space: true,
-		max_particles: 500,
+		max_particles: 100,
 		emit_duration: 0.100,
 		emit_rate: 100.000,
 		initial_burst: 80,
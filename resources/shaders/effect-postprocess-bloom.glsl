@@ -0,0 +1,4 @@
+#define POSTPROCESS_BLOOM
+
+// Anti-aliasing, bloom and scene fade.
+#pragma include inc/postprocess.glinc
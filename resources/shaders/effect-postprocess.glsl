@@ -0,0 +1,2 @@
+// Anti-aliasing and scene fade.
+#pragma include inc/postprocess.glinc
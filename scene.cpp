@@ -2,6 +2,10 @@
 #include "game.h"
 #include "asteroidhandler.h"
 #include "projectilehandler.h"
+#include "lighthandler.h"
+#include "effecthandler.h"
+#include "perfcounters.h"
+#include "utils.h"
 #include <mylly/core/mylly.h>
 #include <mylly/core/time.h>
 #include <mylly/renderer/mesh.h>
@@ -37,16 +41,47 @@ static const LevelBackground levelBackgrounds[] = {
 	{ "bkg3_left2", col(130, 50, 50), col(255, 130, 110), { Vec2(10, 8), Vec2(-5, -3) }, { 1.4f, 0.2f }  }, // 5
 };
 
+// Sprites are shared resources which outlive the scenes. Shaders cloned for them are stored here
+// so they can be reused by later scenes instead of cloning (and leaking) a new one for each scene.
+// The clones are released when the game exits.
+struct ClonedShader {
+
+	sprite_t *sprite;
+	shader_t *shader;
+	shader_t *originalShader; // Restored to the sprite when the clone is released
+};
+
+static arr_t(ClonedShader) clonedShaders = arr_initializer;
+
+// Precomputed fade curve for light flashes (smoothstep from full intensity to zero). The flashes
+// stay bright for a moment and then fade out quickly instead of dimming linearly.
+static const uint32_t FLASH_CURVE_SAMPLES = 17;
+
+static const float flashCurve[FLASH_CURVE_SAMPLES] = {
+	1.0000f, 0.9888f, 0.9570f, 0.9077f, 0.8438f, 0.7681f, 0.6836f, 0.5933f, 0.5000f,
+	0.4067f, 0.3164f, 0.2319f, 0.1562f, 0.0923f, 0.0430f, 0.0112f, 0.0000f,
+};
+
+// -------------------------------------------------------------------------------------------------
+
+bool Scene::s_isShakeEnabled = true;
+uint32_t Scene::s_sceneCount = 0;
+
 // -------------------------------------------------------------------------------------------------
 
 Scene::Scene(void)
 {
+	++s_sceneCount;
 }
 
 Scene::~Scene(void)
 {
+	--s_sceneCount;
+
 	delete m_asteroids;
 	delete m_projectiles;
+	delete m_lights;
+	delete m_effects;
 
 	obj_destroy(m_camera->parent);
 	m_camera = nullptr;
@@ -56,14 +91,6 @@ Scene::~Scene(void)
 	obj_destroy(m_directionalLights[0]->parent);
 	obj_destroy(m_directionalLights[1]->parent);
 
-	uint32_t lightIndex;
-
-	arr_foreach_iter(m_lightFlashes, lightIndex) {
-		obj_destroy(m_lightFlashes.items[lightIndex].light->parent);
-	}
-
-	arr_clear(m_lightFlashes);
-
 	if (m_sceneRoot != nullptr) {
 
 		mylly_set_scene(nullptr);
@@ -73,8 +100,8 @@ Scene::~Scene(void)
 
 void Scene::Create(Game *game)
 {
-	UNUSED(game);
-	
+	m_game = game;
+
 	// Create a scene root.
 	m_sceneRoot = scene_create();
 	mylly_set_scene(m_sceneRoot);
@@ -83,6 +110,12 @@ void Scene::Create(Game *game)
 	m_asteroids = new AsteroidHandler();
 	m_projectiles = new ProjectileHandler();
 
+	// Create a pool of point lights for projectiles and light flashes.
+	m_lights = new LightHandler(m_sceneRoot);
+
+	// Pre-warm emitters for the most common particle effects.
+	m_effects = new EffectHandler(m_sceneRoot);
+
 	CreateCamera();
 }
 
@@ -99,14 +132,6 @@ void Scene::SetBackground(uint32_t backgroundIndex)
 	// Create the non-transparent background object first.
 	// NOTE: See the comment at the end of rsys_render_scene() in rendersystem.c!
 	m_spaceBackground = CreateCameraTexture(levelBackgrounds[backgroundIndex].spriteName);
-
-	// Create a fader texture which covers the entire view of the camera.
-	m_fader = CreateCameraTexture("black", false);
-	obj_set_active(m_fader, false);
-
-	// Clone the black sprite's shader so we can control its colour freely.
-	m_fadeShader = shader_clone(m_fader->sprite->mesh->shader);
-	mesh_set_shader(m_fader->sprite->mesh, m_fadeShader);
 }
 
 void Scene::Update(Game *game)
@@ -116,32 +141,37 @@ void Scene::Update(Game *game)
 	}
 
 	// Process light flashes.
-	float deltaTime = get_time().delta_time;
-	uint32_t lightIndex;
+	float deltaTime = Utils::GetDeltaTime();
 
-	arr_foreach_reverse_iter(m_lightFlashes, lightIndex) {
+	for (uint32_t i = 0; i < m_lightFlashCount;) {
 
-		LightFlash &flash = m_lightFlashes.items[lightIndex];
+		LightFlash &flash = m_lightFlashes[i];
 		flash.elapsed += deltaTime;
 
-		float t = flash.elapsed / flash.duration;
+		if (flash.elapsed >= flash.duration) {
 
-		if (t >= 1) {
-			obj_destroy(flash.light->parent);
-			arr_remove_at(m_lightFlashes, lightIndex);
-		}
-		else {
-			light_set_intensity(flash.light, (1 - t) * flash.intensity);
+			// The order of the flashes doesn't matter, so replace the expired flash with the last one.
+			flash = m_lightFlashes[--m_lightFlashCount];
+			continue;
 		}
+
+		m_lights->AddLight(flash.position, flash.colour, GetFlashIntensity(flash), FLASH_RANGE);
+		i++;
 	}
 
+	PerfCounters::Set(COUNTER_LIGHT_FLASHES, m_lightFlashCount);
+
+	// Assign the most important lights requested this frame to the pooled lights. The camera is
+	// always centered at the origin.
+	m_lights->Update(Vec2(0, 0));
+
 	// Process fade after everything else because when the fade ends the scene can be deleted.
 	if (IsFading()) {
 		ProcessFade(game);
 	}
 }
 
-void Scene::CalculateBoundaries(Vec2 &outMin, Vec2 &outMax)
+void Scene::CalculateBoundaries(Vec2 &outMin, Vec2 &outMax, float padding)
 {
 	if (m_camera == nullptr) {
 
@@ -158,8 +188,6 @@ void Scene::CalculateBoundaries(Vec2 &outMin, Vec2 &outMax)
 	vec3_t min = camera_screen_to_world(m_camera, vec3(0, (float)screenHeight, 0.1f));
 	vec3_t max = camera_screen_to_world(m_camera, vec3((float)screenWidth, 0, 0.1f));
 
-	float padding = 2.0f;
-
 	outMin = vec2(min.x - padding, min.z - padding);
 	outMax = vec2(max.x + padding, max.z + padding);
 }
@@ -184,38 +212,70 @@ void Scene::FadeCamera(bool fadeIn)
 	m_isFadingIn = fadeIn;
 	m_fadeEffectEnds = get_time().real_time + FADE_DURATION;
 
-	// Activate the fader object and set its starting colour.
-	obj_set_active(m_fader, true);
-
+	// Set the starting colour of the fade.
 	colour_t startColour = col_a(0, 0, 0, 255);
 
 	if (!fadeIn) {
 		startColour = col_a(0, 0, 0, 0);
 	}
 
-	shader_set_uniform_colour(m_fadeShader, "Colour", startColour);
+	SetFadeColour(startColour);
 }
 
 void Scene::ShakeCamera(float intensity, float duration)
 {
+	if (!s_isShakeEnabled) {
+		return;
+	}
+
 	m_shakeIntensity = intensity;
 	m_shakeDuration = duration;
 	m_shakeElapsed = 0;
 }
 
-emitter_t *Scene::SpawnEffect(const char *effectName, const Vec2 &position) const
+emitter_t *Scene::SpawnEffect(const char *effectName, const Vec2 &position, float radius) const
 {
+	// The play area extends past the view, so entities can be destroyed where nobody sees them.
+	// Skip the minor effects there, the rest would be simulated for nothing.
+	if (m_effects->IsCullable(effectName) &&
+		!m_game->IsInView(position, radius)) {
+
+		PerfCounters::Increment(COUNTER_EFFECTS_THROTTLED);
+		return nullptr;
+	}
+
+	// Drop the effect if it has been spawned too often in the same area, or if there are already
+	// too many particles in the scene.
+	if (m_effects->IsThrottled(effectName, position) ||
+		!m_effects->ReserveParticles(effectName)) {
+
+		return nullptr;
+	}
+
+	// Use a pooled instance of the effect if one is available.
+	emitter_t *pooledEmitter = m_effects->SpawnEffect(effectName, position);
+
+	if (pooledEmitter != nullptr) {
+
+		m_effects->RecordSpawn(effectName, position);
+		return pooledEmitter;
+	}
+
 	// Find the effect resource.
 	emitter_t *effect = res_get_emitter(effectName);
 
 	if (effect == nullptr) {
+
+		m_effects->ReleaseParticles(effectName);
 		return nullptr;
 	}
 
 	// Spawn the object and attach a particle emitter to it.
-	object_t *effectObject = scene_create_object(m_sceneRoot, nullptr);
+	object_t *effectObject = CreateObject();
 	emitter_t *emitter = obj_add_emitter(effectObject, effect);
 
+	PerfCounters::Increment(COUNTER_EFFECTS_SPAWNED);
+
 	// Move the object to the desired position and rotate it towards the camera.
 	obj_set_position(effectObject, vec3(position.x(), 0, position.y()));
 	obj_set_local_rotation(effectObject, quat_from_euler_deg(90, 0, 0));
@@ -224,38 +284,115 @@ emitter_t *Scene::SpawnEffect(const char *effectName, const Vec2 &position) cons
 	emitter_set_destroy_when_inactive(emitter, true);
 	emitter_start(emitter);
 
+	m_effects->RecordSpawn(effectName, position);
+
 	return emitter;
 }
 
 void Scene::SpawnLightFlash(const Vec2 &position, const colour_t &colour,
                      float intensity, float duration)
 {
-	// Create a light instance into the scene.
-	object_t *object = scene_create_object(m_sceneRoot, nullptr);
-	light_t *light = obj_add_light(object);
+	// Merge flashes which are close to each other (i.e. chain explosions) into a single light.
+	for (uint32_t i = 0; i < m_lightFlashCount; i++) {
+
+		LightFlash &flash = m_lightFlashes[i];
+
+		Vec2 offset = flash.position - position;
+
+		if (offset.Dot(offset) > FLASH_MERGE_DISTANCE * FLASH_MERGE_DISTANCE) {
+			continue;
+		}
+
+		// Restart the existing flash at the combined intensity of the two, so chain explosions
+		// light up brighter without blowing out the scene, and move it towards the brighter flash.
+		float currentIntensity = GetFlashIntensity(flash);
+		float totalIntensity = intensity + currentIntensity;
+
+		// Nothing to weigh the position with, e.g. a zero intensity flash next to one which has
+		// faded out.
+		if (totalIntensity <= 0) {
+			continue;
+		}
+
+		float weight = intensity / totalIntensity;
+
+		flash.position = flash.position + (position - flash.position) * weight;
+
+		if (intensity > currentIntensity) {
+			flash.colour = colour;
+		}
+
+		flash.intensity = totalIntensity;
+
+		if (flash.intensity > MAX_FLASH_INTENSITY) {
+			flash.intensity = MAX_FLASH_INTENSITY;
+		}
+
+		flash.duration = (duration > flash.duration - flash.elapsed ?
+		                  duration : flash.duration - flash.elapsed);
+		flash.elapsed = 0;
+
+		return;
+	}
+
+	// Store the flash to the pool so it can be dimmed. The light handler assigns an actual light to
+	// the flash for as long as it's among the most important lights in the scene. When the pool is
+	// full, the dimmest flash is replaced.
+	uint32_t flashIndex = m_lightFlashCount;
+
+	if (m_lightFlashCount < MAX_LIGHT_FLASHES) {
+		m_lightFlashCount++;
+	}
+	else {
+
+		flashIndex = 0;
 
-	obj_set_position(object, vec3(position.x(), 0, position.y()));
+		for (uint32_t i = 1; i < m_lightFlashCount; i++) {
 
-	light_set_type(light, LIGHT_POINT);
-	light_set_colour(light, colour);
-	light_set_intensity(light, intensity);
-	light_set_range(light, 20);
+			if (GetFlashIntensity(m_lightFlashes[i]) < GetFlashIntensity(m_lightFlashes[flashIndex])) {
+				flashIndex = i;
+			}
+		}
+	}
 
-	// Store the light to a list so it can be dimmed.
-	LightFlash flash;
+	LightFlash &flash = m_lightFlashes[flashIndex];
 
-	flash.light = light;
+	flash.position = position;
+	flash.colour = colour;
 	flash.intensity = intensity;
 	flash.duration = duration;
 	flash.elapsed = 0;
+}
+
+float Scene::GetFlashIntensity(const LightFlash &flash)
+{
+	// Look up the fade curve and interpolate between the two nearest samples.
+	float t = flash.elapsed / flash.duration * (FLASH_CURVE_SAMPLES - 1);
+
+	if (t <= 0) {
+		return flash.intensity;
+	}
+
+	if (t >= FLASH_CURVE_SAMPLES - 1) {
+		return 0;
+	}
+
+	uint32_t sample = (uint32_t)t;
+	float fraction = t - sample;
 
-	arr_push(m_lightFlashes, flash);
+	float curve = flashCurve[sample] + (flashCurve[sample + 1] - flashCurve[sample]) * fraction;
+	return curve * flash.intensity;
+}
+
+object_t *Scene::CreateObject(void) const
+{
+	return Utils::CreateObject(m_sceneRoot);
 }
 
 void Scene::CreateCamera(void)
 {
 	// Create a camera object and add it to the scene.
-	object_t *cameraObject = scene_create_object(m_sceneRoot, nullptr);
+	object_t *cameraObject = CreateObject();
 	m_camera = obj_add_camera(cameraObject);
 
 	// Setup the camera's view.
@@ -264,8 +401,12 @@ void Scene::CreateCamera(void)
 
 	camera_set_orthographic_projection(m_camera, 45, ORTOGRAPHIC_NEAR, 100);
 
-	// Apply anti-aliasing to the rendering result.
-	camera_add_post_processing_effect(m_camera, res_get_shader("effect-fxaa"));
+	// Apply anti-aliasing and the scene fade to the rendering result in a single pass.
+	m_postProcessShader = res_get_shader("effect-postprocess");
+	m_isBloomEnabled = false;
+
+	SetFadeColour(col_a(0, 0, 0, 0));
+	AddCameraEffect(m_postProcessShader);
 
 	// Make the camera the audio listener.
 	audio_set_listener(cameraObject);
@@ -274,7 +415,7 @@ void Scene::CreateCamera(void)
 object_t *Scene::CreateCameraTexture(const char *spriteName, bool isBackground)
 {
 	// Create an object for the background element and attach a sprite to it.
-	object_t *object = scene_create_object(m_sceneRoot, nullptr);
+	object_t *object = CreateObject();
 	obj_set_position(object, vec3(0, (isBackground ? 20.0f : -49.0f), 0));
 
 	sprite_t *sprite = res_get_sprite(spriteName);
@@ -283,7 +424,7 @@ object_t *Scene::CreateCameraTexture(const char *spriteName, bool isBackground)
 	// Create a copy of the default sprite shader and make it draw in the background queue.
 	if (isBackground) {
 
-		shader_t *bg_shader = shader_clone(sprite->mesh->shader);
+		shader_t *bg_shader = CloneSpriteShader(sprite);
 		shader_set_render_queue(bg_shader, QUEUE_BACKGROUND);
 
 		sprite_set_shader(sprite, bg_shader);
@@ -305,6 +446,63 @@ object_t *Scene::CreateCameraTexture(const char *spriteName, bool isBackground)
 	return object;
 }
 
+shader_t *Scene::CloneSpriteShader(sprite_t *sprite)
+{
+	uint32_t index;
+
+	arr_foreach_iter(clonedShaders, index) {
+
+		if (clonedShaders.items[index].sprite == sprite) {
+			return clonedShaders.items[index].shader;
+		}
+	}
+
+	ClonedShader clone;
+
+	clone.sprite = sprite;
+	clone.originalShader = sprite->mesh->shader;
+	clone.shader = shader_clone(clone.originalShader);
+
+	arr_push(clonedShaders, clone);
+
+	return clone.shader;
+}
+
+void Scene::ReleaseClonedShaders(void)
+{
+	ClonedShader clone;
+
+	arr_foreach(clonedShaders, clone) {
+
+		sprite_set_shader(clone.sprite, clone.originalShader);
+		shader_destroy(clone.shader);
+	}
+
+	arr_clear(clonedShaders);
+}
+
+uint32_t Scene::GetObjectCount(void) const
+{
+	return m_sceneRoot->objects.count;
+}
+
+uint32_t Scene::GetEmitterCount(void) const
+{
+	// Count emitters through the engine's own object list so one-shot effects which destroy
+	// themselves are included as long as they are alive.
+	uint32_t count = 0;
+	object_t *object;
+
+	arr_foreach(m_sceneRoot->objects, object) {
+
+		if (object->emitter != nullptr) {
+			++count;
+		}
+	}
+
+	return count;
+}
+
 void Scene::SetupLighting(void)
 {
 	const LevelBackground &background = levelBackgrounds[m_backgroundIndex];
@@ -315,7 +513,7 @@ void Scene::SetupLighting(void)
 	// Create two directional lights to light the ship and other 3D objects.
 	for (int i = 0; i < 2; i++) {
 		
-		object_t *lightObject = scene_create_object(m_sceneRoot, nullptr);
+		object_t *lightObject = CreateObject();
 		light_t *light = obj_add_light(lightObject);
 
 		m_directionalLights[i] = light;
@@ -337,7 +535,9 @@ void Scene::ProcessFade(Game *game)
 
 		m_fadeFactor = (m_isFadingIn ? 0 : 1);
 		m_fadeEffectEnds = 0;
-		obj_set_active(m_fader, false);
+
+		// Leave the view black after fading out, the scene is about to be unloaded.
+		SetFadeColour(col_a(0, 0, 0, m_isFadingIn ? 0 : 255));
 
 		if (m_isFadingIn) {
 			// When fading in, we're loading a new scene.
@@ -367,7 +567,33 @@ void Scene::ProcessFade(Game *game)
 	}
 
 	colour_t fadeColour = col_lerp(start, end, t);
-	shader_set_uniform_colour(m_fadeShader, "Colour", fadeColour);
+	SetFadeColour(fadeColour);
+}
+
+void Scene::SetFadeColour(const colour_t &colour)
+{
+	m_fadeColour = colour;
+
+	if (m_postProcessShader != nullptr) {
+		shader_set_uniform_colour(m_postProcessShader, "FadeColour", colour);
+	}
+}
+
+void Scene::SetBloomEnabled(bool isEnabled)
+{
+	if (isEnabled == m_isBloomEnabled) {
+		return;
+	}
+
+	m_isBloomEnabled = isEnabled;
+
+	// Replace the post processing pass with the other variant. The variants are separate shader
+	// resources so the fade colour has to be copied over.
+	RemoveCameraEffect(m_postProcessShader);
+
+	m_postProcessShader = res_get_shader(isEnabled ? "effect-postprocess-bloom" : "effect-postprocess");
+	SetFadeColour(m_fadeColour);
+	AddCameraEffect(m_postProcessShader);
 }
 
 void Scene::ProcessShake(void)
@@ -17,7 +17,8 @@ enum SceneType {
 // -------------------------------------------------------------------------------------------------
 
 struct LightFlash {
-	light_t *light;
+	Vec2 position;
+	colour_t colour;
 	float intensity;
 	float duration;
 	float elapsed;
@@ -40,32 +41,56 @@ public:
 	scene_t *GetSceneRoot(void) const { return m_sceneRoot; }
 	AsteroidHandler *GetAsteroidHandler(void) const { return m_asteroids; }
 	ProjectileHandler *GetProjectileHandler(void) const { return m_projectiles; }
+	LightHandler *GetLightHandler(void) const { return m_lights; }
+	EffectHandler *GetEffectHandler(void) const { return m_effects; }
 
-	void CalculateBoundaries(Vec2 &outMin, Vec2 &outMax);
+	void CalculateBoundaries(Vec2 &outMin, Vec2 &outMax, float padding = BOUNDARY_PADDING);
 
 	void AddCameraEffect(shader_t *effect);
 	void RemoveCameraEffect(shader_t *effect);
 
+	// Switches between the post processing shader variants with and without bloom. The bloom
+	// uniforms can be set through the shader returned by GetPostProcessShader().
+	void SetBloomEnabled(bool isEnabled);
+	shader_t *GetPostProcessShader(void) const { return m_postProcessShader; }
+
 	void FadeCamera(bool fadeIn);
 	void ShakeCamera(float intensity = 1, float duration = 0.5f);
+	static void SetShakeEnabled(bool isEnabled) { s_isShakeEnabled = isEnabled; }
 
 	float GetCameraFadeFactor(void) const { return m_fadeFactor; }
 
-	emitter_t *SpawnEffect(const char *effectName, const Vec2 &position) const;
+	// Spawns a one-shot effect. The radius is the size of the thing spawning the effect, minor
+	// effects are skipped when it's entirely outside the view.
+	emitter_t *SpawnEffect(const char *effectName, const Vec2 &position, float radius = 0) const;
 	void SpawnLightFlash(const Vec2 &position, const colour_t &colour = COL_WHITE,
 	                     float intensity = 1.0f, float duration = 1.0f);
 
+	uint32_t GetLightFlashCount(void) const { return m_lightFlashCount; }
+	static uint32_t GetSceneCount(void) { return s_sceneCount; }
+
+	// Releases the shaders cloned for shared sprites. Call after all scenes have been deleted.
+	static void ReleaseClonedShaders(void);
+
+	uint32_t GetObjectCount(void) const;
+	uint32_t GetEmitterCount(void) const;
+
 	virtual void OnEntityDestroyed(Game *game, Entity *entity) = 0;
 
 protected:
+	object_t *CreateObject(void) const;
 	void CreateCamera(void);
 
 	void SetBackground(uint32_t backgroundIndex);
 	object_t *CreateCameraTexture(const char *spriteName, bool isBackground = true);
+	static shader_t *CloneSpriteShader(sprite_t *sprite);
 	void SetupLighting(void);
 
+	static float GetFlashIntensity(const LightFlash &flash);
+
 	bool IsFading(void) const { return (m_fadeEffectEnds != 0); }
 	void ProcessFade(Game *game);
+	void SetFadeColour(const colour_t &colour);
 
 	bool IsShaking(void) const { return (m_shakeDuration != 0); }
 	void ProcessShake(void);
@@ -73,9 +98,18 @@ protected:
 protected:
 	static constexpr float FADE_DURATION = 0.5f;
 	static constexpr float CAMERA_DEPTH = -50.0f;
+	static constexpr float BOUNDARY_PADDING = 2.0f; // Play area extends this much past the view
+	static constexpr float FLASH_RANGE = 20.0f;
+	static constexpr float FLASH_MERGE_DISTANCE = 4.0f;
+	static constexpr float MAX_FLASH_INTENSITY = 30.0f; // Limit for merged flashes
+	static constexpr uint32_t MAX_LIGHT_FLASHES = 32;
+
+	const Game *m_game = nullptr;
 
 	AsteroidHandler *m_asteroids = nullptr;
 	ProjectileHandler *m_projectiles = nullptr;
+	LightHandler *m_lights = nullptr;
+	EffectHandler *m_effects = nullptr;
 
 	scene_t *m_sceneRoot = nullptr;
 	camera_t *m_camera = nullptr;
@@ -84,8 +118,10 @@ protected:
 
 	uint32_t m_backgroundIndex = 0;
 
-	object_t *m_fader = nullptr;
-	shader_t *m_fadeShader = nullptr;
+	shader_t *m_postProcessShader = nullptr; // Fused AA/bloom/fade pass, see inc/postprocess.glinc
+	bool m_isBloomEnabled = false;
+	colour_t m_fadeColour = col_a(0, 0, 0, 0);
+
 	float m_fadeEffectEnds = 0;
 	bool m_isFadingIn = false;
 	float m_fadeFactor = 0;
@@ -94,5 +130,9 @@ protected:
 	float m_shakeIntensity = 0;
 	float m_shakeElapsed = 0;
 
-	arr_t(LightFlash) m_lightFlashes = arr_initializer;
+	static bool s_isShakeEnabled;
+	static uint32_t s_sceneCount; // Scenes created and not yet deleted
+
+	LightFlash m_lightFlashes[MAX_LIGHT_FLASHES];
+	uint32_t m_lightFlashCount = 0;
 };
@@ -4,11 +4,11 @@
 #include "projectile.h"
 #include "inputhandler.h"
 #include "warpeffect.h"
+#include "utils.h"
 #include <mylly/scene/object.h>
 #include <mylly/scene/scene.h>
 #include <mylly/scene/emitter.h>
 #include <mylly/resources/resources.h>
-#include <mylly/core/time.h>
 #include <mylly/math/math.h>
 #include <mylly/audio/audiosystem.h>
 
@@ -18,6 +18,33 @@ constexpr float Ship::WEAPON_FIRE_RATES[3];
 
 // -------------------------------------------------------------------------------------------------
 
+static quat_t InverseRotation(const quat_t &rotation)
+{
+	// The conjugate of a unit quaternion is its inverse.
+	quat_t inverse = rotation;
+
+	inverse.x = -rotation.x;
+	inverse.y = -rotation.y;
+	inverse.z = -rotation.z;
+
+	return inverse;
+}
+
+static vec3_t RotateVector(const quat_t &rotation, const vec3_t &vector)
+{
+	quat_t point = rotation;
+
+	point.x = vector.x;
+	point.y = vector.y;
+	point.z = vector.z;
+	point.w = 0;
+
+	point = quat_multiply(quat_multiply(rotation, point), InverseRotation(rotation));
+	return vec3(point.x, point.y, point.z);
+}
+
+// -------------------------------------------------------------------------------------------------
+
 Ship::Ship(void) :
 	Entity(ENTITY_SHIP)
 {
@@ -44,24 +71,15 @@ void Ship::Spawn(Game *game)
 		return;
 	}
 
-	// Create an empty parent object for the ship. This is because the ship model is rotated
-	// in a weird way and we want to be able to set the ship's heading without too complex math.
+	// Create an object for the ship and attach the model to it. The model's fixed rotation is
+	// combined with the ship's heading so the ship doesn't need a separate parent object.
 	SetSceneObject(game->SpawnSceneObject());
+	obj_set_model(GetSceneObject(), shipModel);
 
-	// Create an object under the empty parent and attach the model to it.
-	object_t *shipObject = game->SpawnSceneObject(GetSceneObject());
-	obj_set_model(shipObject, shipModel);
-
-	// Make the model a bit smaller.
-	obj_set_local_scale(shipObject, vec3(0.8f, 0.8f, 0.8f));
-
-	// Rotate the ship model so it's top side up, heading right.
-	obj_set_local_rotation(shipObject, quat_from_euler_deg(180, 90, 0));
+	m_model = shipModel;
 
-	// Attach a particle emitter to the ship for the engine acceleration effect.
-	m_trailEmitter = game->GetScene()->SpawnEffect("engine-trail", GetPosition());
-
-	emitter_set_destroy_when_inactive(m_trailEmitter, false);
+	obj_set_local_rotation(GetSceneObject(), GetRotation());
+	SetStretch(1, 1);
 
 	// Spawn a warp effect.
 	m_warpEffect = new WarpEffect(this);
@@ -74,9 +92,15 @@ void Ship::Destroy(Game *game)
 		return;
 	}
 
-	// Stop trail particle emitter. The effect is automatically destroyed when it no longer has
-	// active particles.
-	emitter_stop(m_trailEmitter);
+	// Detach and stop the trail particle emitter. The effect is automatically destroyed when it
+	// no longer has active particles.
+	Vec2 trailOffset = vec2_rotate(Vec2(TRAIL_OFFSET, 0).vec(), -DEG_TO_RAD(m_heading));
+	Vec2 trailPosition = GetPosition() + trailOffset;
+
+	DetachEmitter(m_trailEmitter, vec3(trailPosition.x(), GetDrawDepth(), trailPosition.y()),
+	              quat_from_euler_deg(90, 0, 90 - m_heading));
+
+	m_trailEmitter = nullptr;
 
 	// Do final cleanup.
 	Entity::Destroy(game);
@@ -85,20 +109,10 @@ void Ship::Destroy(Game *game)
 void Ship::Update(Game *game)
 {
 	// Update the ship's transformation.
-	obj_set_position(GetSceneObject(), GetScenePosition().vec());
-	obj_set_local_rotation(GetSceneObject(), quat_from_euler_deg(0, m_heading, 0));
-
-	// Update trail emitter position in the scene.
-	if (m_trailEmitter != nullptr) {
-
-		Vec2 effectOffset = Vec2(-1.2f, 0);
-		effectOffset = vec2_rotate(effectOffset.vec(), -DEG_TO_RAD(m_heading));
+	if (IsVisible()) {
 
-		Vec2 effectPosition = GetPosition() + effectOffset;
-		vec3_t position = vec3(effectPosition.x(), GetDrawDepth(), effectPosition.y());
-
-		obj_set_position(m_trailEmitter->parent, position);
-		obj_set_local_rotation(m_trailEmitter->parent, quat_from_euler_deg(90, 0, 90 - m_heading));
+		obj_set_position(GetSceneObject(), GetScenePosition().vec());
+		obj_set_local_rotation(GetSceneObject(), GetRotation());
 	}
 
 	// Update warp effect.
@@ -108,15 +122,79 @@ void Ship::Update(Game *game)
 		// The effect has finished, destroy it.
 		delete m_warpEffect;
 		m_warpEffect = nullptr;
+
+		// The warp effect no longer scales the ship, the engine trail can now be attached.
+		AttachTrail(game);
 	}
 
 	Entity::Update(game);
 }
 
+void Ship::AttachTrail(Game *game)
+{
+	if (m_trailEmitter != nullptr) {
+		return;
+	}
+
+	// Attach a particle emitter behind the ship for the engine acceleration effect. The emitter is
+	// rotated towards the camera and follows the ship's heading through its parent. The ship's
+	// object also carries the model's rotation and scale, the trail's local transform cancels
+	// them out.
+	m_trailEmitter = game->GetScene()->SpawnEffect("engine-trail", GetPosition());
+
+	float shipScale = MODEL_SCALE * SCALE;
+	quat_t inverseModelRotation = InverseRotation(m_modelRotation);
+
+	Vec3 trailOffset = RotateVector(inverseModelRotation, vec3(TRAIL_OFFSET, GetDrawDepth(), 0));
+	trailOffset *= 1.0f / shipScale;
+
+	quat_t trailRotation = quat_multiply(inverseModelRotation, quat_from_euler_deg(90, 0, 90));
+
+	AttachEmitter(m_trailEmitter, trailOffset.vec(), trailRotation, 1.0f / shipScale);
+}
+
+void Ship::SetStretch(float length, float width)
+{
+	if (!IsSpawned()) {
+		return;
+	}
+
+	// The model's Z axis points along the ship's heading after the model rotation, X and Y are
+	// across it.
+	Vec3 scale = Vec3(width, width, length) * MODEL_SCALE;
+	obj_set_local_scale(GetSceneObject(), scale.vec());
+}
+
+quat_t Ship::GetRotation(void) const
+{
+	return quat_multiply(quat_from_euler_deg(0, m_heading, 0), m_modelRotation);
+}
+
+void Ship::SetVisualsActive(bool isActive)
+{
+	// Only remove the model, the engine trail is a child of the same object and its particles
+	// should fade out normally.
+	obj_set_model(GetSceneObject(), isActive ? m_model : nullptr);
+}
+
+void Ship::OnVisibilityChanged(Game *game, bool isVisible)
+{
+	UNUSED(game);
+
+	// Stop the engine trail while the ship is outside the view, it is started again when the
+	// ship accelerates.
+	if (!isVisible &&
+		m_trailEmitter != nullptr &&
+		m_trailEmitter->is_emitting) {
+
+		emitter_stop(m_trailEmitter);
+	}
+}
+
 void Ship::ProcessInput(Game *game)
 {
-	float time = get_time().time;
-	float dt = get_time().delta_time;
+	float time = Utils::GetTime();
+	float dt = Utils::GetDeltaTime();
 
 	// Process ship steering.
 	float steering = game->GetInputHandler()->GetSteering();
@@ -154,11 +232,11 @@ void Ship::ProcessInput(Game *game)
 		SetVelocity(velocity);
 
 		// Activate the trail emitter when the ship is accelerating.
-		if (!m_trailEmitter->is_emitting) {
+		if (m_trailEmitter != nullptr && !m_trailEmitter->is_emitting && IsVisible()) {
 			emitter_start(m_trailEmitter);
 		}
 	}
-	else if (m_trailEmitter->is_emitting) {
+	else if (m_trailEmitter != nullptr && m_trailEmitter->is_emitting) {
 		emitter_stop(m_trailEmitter);
 	}
 
@@ -217,7 +295,7 @@ void Ship::FireWeapon(Game *game)
 				);
 			}
 
-			sound = audio_play_sound(res_get_sound("Laser2"), 0);
+			sound = Utils::PlaySound("Laser2", 0);
 			audio_set_sound_gain(sound, 50.0f);
 			break;
 
@@ -238,7 +316,7 @@ void Ship::FireWeapon(Game *game)
 				);
 			}
 
-			audio_play_sound(res_get_sound("Laser3"), 0);
+			Utils::PlaySound("Laser3", 0);
 			break;
 
 		default:
@@ -251,7 +329,7 @@ void Ship::FireWeapon(Game *game)
 			);
 
 			// Play a laser fire sound effect.
-			audio_play_sound(res_get_sound("Laser"), 0);
+			Utils::PlaySound("Laser", 0);
 			break;
 	}
 }
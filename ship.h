@@ -18,25 +18,41 @@ public:
 	// Call this before update.
 	void ProcessInput(Game *game);
 
+	float GetHeading(void) const { return m_heading; }
+
+	// Scales the ship along its heading and across it, relative to the model's normal size.
+	void SetStretch(float length, float width);
+
 	virtual void OnCollideWith(const Game *game, Entity *other) override;
 
+protected:
+	virtual void SetVisualsActive(bool isActive) override;
+	virtual void OnVisibilityChanged(Game *game, bool isVisible) override;
+
 private:
 	void UpdateControls(const InputHandler *input);
 	void FireWeapon(Game *game);
+	void AttachTrail(Game *game);
+	quat_t GetRotation(void) const;
 
 public:
 	static constexpr float RADIUS = 2.0f;
+	static constexpr float SCALE = 0.8f; // Scale of the ship after the warp effect has finished
 
 private:
 	static constexpr float TURN_SPEED = 180; // degrees/sec
 	static constexpr float ACCELERATION = 40; // units/sec^2
 	static constexpr float MAX_SPEED = 20; // units/sec
+	static constexpr float MODEL_SCALE = 0.8f; // Makes the model a bit smaller
+	static constexpr float TRAIL_OFFSET = -1.2f; // Position of the engine trail along the heading
 	static constexpr float WEAPON_FIRE_RATES[3] = { 6, 5, 3 }; // shots/sec
 
 	float m_heading = 0;
 	float m_nextWeaponFire = 0;
 
-	emitter_t *m_trailEmitter = nullptr; // Engine trail particle emitter
+	model_t *m_model = nullptr; // Ship model, removed from the object outside the view
+	quat_t m_modelRotation = quat_from_euler_deg(180, 90, 0); // Top side up, heading right
+	emitter_t *m_trailEmitter = nullptr; // Engine trail particle emitter, attached after the warp
 
 	WarpEffect *m_warpEffect = nullptr; // Effect used for spawning the ship
 };
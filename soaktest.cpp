@@ -0,0 +1,245 @@
+#include "soaktest.h"
+#include "game.h"
+#include "collisionhandler.h"
+#include <mylly/core/time.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+constexpr const char *SoakTest::LOG_FILE;
+
+static const char *metricNames[NUM_SOAK_METRICS] = {
+	"rss_kb",
+	"entities",
+	"light_flashes",
+	"objects",
+	"emitters",
+	"scenes",
+};
+
+// How much a metric has to grow from the first sample after warmup before steady growth counts as
+// a leak. Memory usage creeps a bit because of the allocator, and the number of things alive in
+// the scene depends on the level and on how the autopilot happened to play.
+static const uint32_t minimumGrowth[NUM_SOAK_METRICS] = {
+	4 * 1024, // 4 MB
+	5,
+	4,
+	20,
+	5,
+	1,
+};
+
+// -------------------------------------------------------------------------------------------------
+
+SoakTest::SoakTest(uint32_t cycles, float playDuration)
+{
+	m_cycles = cycles;
+	m_playDuration = playDuration;
+
+	memset(m_reference, 0, sizeof(m_reference));
+	memset(m_history, 0, sizeof(m_history));
+
+	m_log = fopen(LOG_FILE, "w");
+
+	if (m_log != nullptr) {
+
+		fprintf(m_log, "cycle,level");
+
+		for (uint32_t i = 0; i < NUM_SOAK_METRICS; i++) {
+			fprintf(m_log, ",%s", metricNames[i]);
+		}
+
+		fprintf(m_log, "\n");
+	}
+}
+
+SoakTest::~SoakTest(void)
+{
+	if (m_log != nullptr) {
+		fclose(m_log);
+	}
+}
+
+void SoakTest::Update(Game *game)
+{
+	if (m_isFinished ||
+		game->GetScene() == nullptr ||
+		game->IsLoadingLevel()) {
+
+		m_sceneStartTime = 0;
+		return;
+	}
+
+	float time = get_time().real_time;
+
+	// Measure time spent in each scene from the moment it has been loaded.
+	if (m_sceneStartTime == 0) {
+		m_sceneStartTime = time;
+	}
+
+	float timeInScene = time - m_sceneStartTime;
+
+	if (game->GetScene()->GetType() == SCENE_MENU) {
+
+		// Let the menu settle before sampling so the previous scene has been cleaned up.
+		if (timeInScene < SETTLE_TIME) {
+			return;
+		}
+
+		if (m_hasPlayed) {
+
+			// The menu is reached both after the play time is over and after a game over. Only the
+			// former is sampled, the cycle counts either way.
+			++m_cycle;
+
+			if (m_cycle >= m_cycles) {
+
+				Finish(game, true);
+				return;
+			}
+		}
+
+		// Start the next cycle. Cycle through levels so each background and lighting setup is used.
+		game->StartNewGame(1 + m_cycle % 6);
+
+		m_hasPlayed = true;
+		m_sceneStartTime = 0;
+	}
+	else if (timeInScene >= m_playDuration) {
+
+		// Played long enough. Sample while the level is still running, the menu has next to nothing
+		// alive in it.
+		if (!TakeSample(game)) {
+			return;
+		}
+
+		game->LoadMainMenu();
+		m_sceneStartTime = 0;
+	}
+}
+
+bool SoakTest::TakeSample(Game *game)
+{
+	Scene *scene = game->GetScene();
+	uint32_t sample[NUM_SOAK_METRICS];
+
+	sample[SOAK_RESIDENT_MEMORY] = GetResidentMemory();
+	sample[SOAK_ENTITIES] = game->GetCollisionHandler()->GetEntityCount();
+	sample[SOAK_LIGHT_FLASHES] = scene->GetLightFlashCount();
+	sample[SOAK_OBJECTS] = scene->GetObjectCount();
+	sample[SOAK_EMITTERS] = scene->GetEmitterCount();
+	sample[SOAK_SCENES] = Scene::GetSceneCount();
+
+	if (m_log != nullptr) {
+
+		fprintf(m_log, "%u,%u", m_cycle + 1, game->GetLevel());
+
+		for (uint32_t i = 0; i < NUM_SOAK_METRICS; i++) {
+			fprintf(m_log, ",%u", sample[i]);
+		}
+
+		fprintf(m_log, "\n");
+		fflush(m_log);
+	}
+
+	// Let the caches fill up and each level get played once before looking for growth.
+	if (m_cycle < WARMUP_CYCLES) {
+		return true;
+	}
+
+	if (m_samples == 0) {
+		memcpy(m_reference, sample, sizeof(m_reference));
+	}
+
+	// Keep a window of the latest samples.
+	uint32_t index = m_samples;
+
+	if (m_samples >= TREND_CYCLES) {
+
+		memmove(m_history[0], m_history[1], sizeof(m_history[0]) * (TREND_CYCLES - 1));
+		index = TREND_CYCLES - 1;
+	}
+
+	memcpy(m_history[index], sample, sizeof(sample));
+	++m_samples;
+
+	if (m_samples < TREND_CYCLES) {
+		return true;
+	}
+
+	// A metric which never goes down during the whole window and has grown clearly since the
+	// first sample after warmup is leaking. Values which bounce around with the gameplay don't
+	// grow on every cycle.
+	for (uint32_t i = 0; i < NUM_SOAK_METRICS; i++) {
+
+		bool isGrowing = true;
+
+		for (uint32_t j = 1; j < TREND_CYCLES && isGrowing; j++) {
+			isGrowing = (m_history[j][i] >= m_history[j - 1][i]);
+		}
+
+		if (isGrowing &&
+			sample[i] > m_history[0][i] &&
+			sample[i] >= m_reference[i] + minimumGrowth[i]) {
+
+			fprintf(stderr, "Soak test failed on cycle %u: %s grew from %u to %u over the last "
+			        "%u cycles (%u after warmup).\n", m_cycle + 1, metricNames[i],
+			        m_history[0][i], sample[i], TREND_CYCLES, m_reference[i]);
+
+			Finish(game, false);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void SoakTest::Finish(Game *game, bool succeeded)
+{
+	m_isFinished = true;
+
+	if (succeeded) {
+		printf("Soak test passed, %u cycles completed.\n", m_cycle);
+	}
+
+	if (m_log != nullptr) {
+
+		fclose(m_log);
+		m_log = nullptr;
+	}
+
+	// Shut down normally either way, the error code on failure lets the test harness notice it.
+	game->Exit(succeeded ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+uint32_t SoakTest::GetResidentMemory(void)
+{
+#if defined(__linux__)
+
+	// The second value in statm is the resident set size in pages.
+	FILE *file = fopen("/proc/self/statm", "r");
+
+	if (file == nullptr) {
+		return 0;
+	}
+
+	unsigned long size = 0, resident = 0;
+	int values = fscanf(file, "%lu %lu", &size, &resident);
+
+	fclose(file);
+
+	if (values != 2) {
+		return 0;
+	}
+
+	return (uint32_t)(resident * (sysconf(_SC_PAGESIZE) / 1024));
+
+#else
+	return 0;
+#endif
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "gamedefs.h"
+#include <stdio.h>
+
+// -------------------------------------------------------------------------------------------------
+
+enum SoakMetric {
+
+	SOAK_RESIDENT_MEMORY, // Resident set size of the process in kilobytes
+	SOAK_ENTITIES, // Entities registered to the collision handler
+	SOAK_LIGHT_FLASHES, // Light flashes alive in the scene
+	SOAK_OBJECTS, // Engine objects alive in the scene
+	SOAK_EMITTERS, // Particle emitters alive in the scene
+	SOAK_SCENES, // Scenes which haven't been deleted
+
+	NUM_SOAK_METRICS
+};
+
+// -------------------------------------------------------------------------------------------------
+
+// Runs the game through a large number of level load -> play -> main menu cycles. At the end of
+// each play phase the soak test samples a few resource metrics. After warmup the test fails if a
+// metric keeps growing on every cycle for a while and has grown clearly from its first value.
+class SoakTest
+{
+public:
+	SoakTest(uint32_t cycles, float playDuration);
+	~SoakTest(void);
+
+	void Update(Game *game);
+
+private:
+	bool TakeSample(Game *game);
+	void Finish(Game *game, bool succeeded);
+
+	static uint32_t GetResidentMemory(void);
+
+private:
+	static constexpr uint32_t NUM_LEVELS = 6; // Number of levels the test cycles through
+	static constexpr uint32_t WARMUP_CYCLES = NUM_LEVELS; // Cycles not checked for growth
+	static constexpr uint32_t TREND_CYCLES = 8; // Consecutive cycles of growth counted as a leak
+	static constexpr float SETTLE_TIME = 0.5f; // Seconds to wait in the menu before the next cycle
+
+	static constexpr const char *LOG_FILE = "soak.csv";
+
+	uint32_t m_cycles = 0; // Number of cycles to run
+	uint32_t m_cycle = 0; // Number of cycles completed
+	float m_playDuration = 0; // Seconds to play in each cycle
+
+	bool m_hasPlayed = false;
+	bool m_isFinished = false; // Set once the result is known, the engine exits on the next frame
+	float m_sceneStartTime = 0; // Time when the current scene finished loading, 0 while loading
+
+	uint32_t m_samples = 0; // Samples taken after warmup
+	uint32_t m_reference[NUM_SOAK_METRICS]; // First sample after warmup
+	uint32_t m_history[TREND_CYCLES][NUM_SOAK_METRICS]; // Latest samples, oldest first
+
+	FILE *m_log = nullptr;
+};
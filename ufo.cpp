@@ -8,7 +8,6 @@
 #include <mylly/scene/object.h>
 #include <mylly/scene/scene.h>
 #include <mylly/resources/resources.h>
-#include <mylly/core/time.h>
 #include <mylly/math/math.h>
 #include <mylly/ai/ai.h>
 #include <mylly/ai/behaviour.h>
@@ -28,7 +27,7 @@ Ufo::Ufo(void) :
 	SetVelocity(Vec2(1, 0));
 
 	// Make sure the UFO can't fire during the first 3 seconds.
-	m_nextWeaponFire = get_time().time + 3.0f;
+	m_nextWeaponFire = Utils::GetTime() + 3.0f;
 }
 
 Ufo::~Ufo(void)
@@ -50,23 +49,21 @@ void Ufo::Spawn(Game *game)
 		return;
 	}
 
-	// Create an empty parent object for the ship. This is because the ship model is rotated
-	// in a weird way and we want to be able to set the ship's heading without too complex math.
-	SetSceneObject(game->SpawnSceneObject());
+	// Create an object for the UFO and attach the model to it.
+	object_t *shipObject = game->SpawnSceneObject();
+	SetSceneObject(shipObject);
 
-	// Create an object under the empty parent and attach the model to it.
-	object_t *shipObject = game->SpawnSceneObject(GetSceneObject());
 	obj_set_model(shipObject, shipModel);
 
 	// Make the model a bit smaller.
 	obj_set_local_scale(shipObject, vec3(0.3f, 0.3f, 0.3f));
 
-	// Rotate the UFO model so it's top side up, heading right.
-	obj_set_local_rotation(shipObject, quat_from_euler_deg(180, 90, 0));
+	// The model is rotated in a weird way, combine its fixed rotation with the UFO's heading.
+	obj_set_local_rotation(shipObject, GetRotation());
 
 	// Attach a looping UFO engine sound to the UFO.
 	obj_add_audio_source(shipObject);
-	sound_instance_t sound = audio_play_sound_from_source(res_get_sound("UfoLoop"), shipObject->audio_source);
+	sound_instance_t sound = Utils::PlaySoundFromSource("UfoLoop", shipObject);
 
 	audio_set_sound_looping(sound, true);
 
@@ -82,7 +79,7 @@ void Ufo::Spawn(Game *game)
 
 void Ufo::Update(Game *game)
 {
-	float dt = get_time().delta_time;
+	float dt = Utils::GetDeltaTime();
 
 	// Apply movement.
 	Vec2 movement = GetVelocity() * dt;
@@ -91,8 +88,11 @@ void Ufo::Update(Game *game)
 	SetPosition(target);
 
 	// Update the UFO's transformation.
-	obj_set_position(GetSceneObject(), GetScenePosition().vec());
-	obj_set_local_rotation(GetSceneObject(), quat_from_euler_deg(0, m_heading, 0));
+	if (IsVisible()) {
+
+		obj_set_position(GetSceneObject(), GetScenePosition().vec());
+		obj_set_local_rotation(GetSceneObject(), GetRotation());
+	}
 
 	Entity::Update(game);
 }
@@ -162,7 +162,7 @@ ai_state_t Ufo::ProcessMovement(void)
 	float targetHeading = CalculateLocalAvoidance(direction);
 
 	// Lerp the UFO's heading towards the target heading.
-	float dt = get_time().delta_time;
+	float dt = Utils::GetDeltaTime();
 	m_heading = Utils::RotateTowards(m_heading, targetHeading, dt * TURN_SPEED);
 
 	// Apply direction to velocity.
@@ -229,7 +229,7 @@ ai_state_t Ufo::FireWeaponsWhenCloseEnough(void)
 	}
 
 	// Can the UFO fire again just yet?
-	float time = get_time().time;
+	float time = Utils::GetTime();
 
 	if (time < m_nextWeaponFire) {
 		return AI_STATE_FAILURE;
@@ -256,7 +256,7 @@ ai_state_t Ufo::FireWeaponsWhenCloseEnough(void)
 	);
 
 	// Play a laser fire sound effect.
-	audio_play_sound(res_get_sound("UfoLaser"), 0);
+	Utils::PlaySound("UfoLaser", 0);
 
 	// Set weapon on cooldown.
 	m_nextWeaponFire = time + 1.0f / WEAPON_FIRE_RATE;
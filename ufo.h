@@ -2,6 +2,7 @@
 
 #include "entity.h"
 #include <mylly/ai/node.h>
+#include <mylly/math/quaternion.h>
 
 // -------------------------------------------------------------------------------------------------
 
@@ -19,6 +20,8 @@ public:
 private:
 	void SetupAI(void);
 
+	quat_t GetRotation(void) const { return quat_multiply(quat_from_euler_deg(0, m_heading, 0), m_modelRotation); }
+
 	// Ideally AI tasks would exist in their own classes but since this is a simple demo we don't
 	// want to clutter things too much with small classes.
 	static ai_state_t AI_ProcessMovement(void *context);
@@ -37,6 +40,7 @@ private:
 	static constexpr float WEAPON_FIRE_RATE = 0.5f; // shots/sec
 
 	float m_heading = 0;
+	quat_t m_modelRotation = quat_from_euler_deg(180, 90, 0); // Turns the model top side up, heading right
 
 	float m_nextWeaponFire = 0;
 
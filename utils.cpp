@@ -1,8 +1,18 @@
 #include "utils.h"
+#include "perfcounters.h"
 #include <time.h>
 #include <stdlib.h>
+#include <mylly/core/time.h>
 #include <mylly/math/math.h>
 #include <mylly/resources/resources.h>
+#include <mylly/scene/scene.h>
+#include <mylly/scene/object.h>
+
+// -------------------------------------------------------------------------------------------------
+
+float Utils::s_fixedTimeStep = 0;
+float Utils::s_time = 0;
+float Utils::s_deltaTime = 0;
 
 // -------------------------------------------------------------------------------------------------
 
@@ -12,6 +22,25 @@ void Utils::Initialize(void)
 	srand(time(NULL));
 }
 
+void Utils::SetRandomSeed(unsigned int seed)
+{
+	srand(seed);
+}
+
+void Utils::UpdateTime(void)
+{
+	if (s_fixedTimeStep == 0) {
+
+		s_time = get_time().time;
+		s_deltaTime = get_time().delta_time;
+		return;
+	}
+
+	// The engine's time scale is 0 while the game is paused, keep the game paused then too.
+	s_deltaTime = (get_time().delta_time > 0 ? s_fixedTimeStep : 0);
+	s_time += s_deltaTime;
+}
+
 float Utils::Random(float min, float max)
 {
 	return min + ((float)rand() / RAND_MAX) * (max - min);
@@ -27,6 +56,27 @@ bool Utils::FlipCoin(void)
 	return ((rand() & 1) == 0);
 }
 
+sound_instance_t Utils::PlaySound(const char *soundName, int group)
+{
+	PerfCounters::Increment(COUNTER_SOUNDS_STARTED);
+
+	return audio_play_sound(res_get_sound(soundName), group);
+}
+
+sound_instance_t Utils::PlaySoundFromSource(const char *soundName, object_t *source)
+{
+	PerfCounters::Increment(COUNTER_SOUNDS_STARTED);
+
+	return audio_play_sound_from_source(res_get_sound(soundName), source->audio_source);
+}
+
+object_t *Utils::CreateObject(scene_t *scene, object_t *parent)
+{
+	PerfCounters::Increment(COUNTER_OBJECTS_CREATED);
+
+	return scene_create_object(scene, parent);
+}
+
 float Utils::RotateTowards(float current, float target, float amount)
 {
 	float a = target - current;
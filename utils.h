@@ -2,6 +2,7 @@
 
 #include "gamedefs.h"
 #include "vector.h"
+#include <mylly/audio/audiosystem.h>
 
 // -------------------------------------------------------------------------------------------------
 
@@ -9,13 +10,33 @@ class Utils
 {
 public:
 	static void Initialize(void);
+	static void SetRandomSeed(unsigned int seed);
+
+	// Game time advanced once per frame. By default it follows the engine's scaled time. With a
+	// fixed time step every frame advances the game by the same amount regardless of how long the
+	// frame really took, so benchmark runs play out the same way.
+	static void UpdateTime(void);
+	static void SetFixedTimeStep(float timeStep) { s_fixedTimeStep = timeStep; }
+	static float GetTime(void) { return s_time; }
+	static float GetDeltaTime(void) { return s_deltaTime; }
 
 	static float Random(float min, float max);
 	static int Random(int min, int max);
 	static bool FlipCoin(void);
 
+	static sound_instance_t PlaySound(const char *soundName, int group = 0);
+	static sound_instance_t PlaySoundFromSource(const char *soundName, object_t *source);
+
+	// Creates a scene object and counts it for the hot path counters.
+	static object_t *CreateObject(scene_t *scene, object_t *parent = nullptr);
+
 	static float RotateTowards(float current, float target, float amount);
 
 	static void GetRandomSpawnPosition(const Vec2 &boundsMin, const Vec2 &boundsMax,
 	                                   Vec2 &position, Vec2 &direction);
+
+private:
+	static float s_fixedTimeStep; // 0 to follow the engine's time
+	static float s_time;
+	static float s_deltaTime;
 };
@@ -2,7 +2,7 @@
 #include "game.h"
 #include "ship.h"
 #include "scene.h"
-#include <mylly/core/time.h>
+#include "utils.h"
 #include <mylly/scene/object.h>
 #include <mylly/scene/emitter.h>
 #include <mylly/renderer/shader.h>
@@ -27,54 +27,59 @@ void WarpEffect::Setup(Game* game)
 	game->GetScene()->SpawnEffect("ftl", m_playerShip->GetPosition());
 
 	// Scale the player's ship to a very small size.
-	obj_set_local_scale(m_playerShip->GetSceneObject(), vec3(0, 0, 0));
+	m_playerShip->SetStretch(0, 0);
 
+	// Enable bloom in the scene's post processing pass and store a reference to the shader so
+	// the bloom can be faded out.
+	game->GetScene()->SetBloomEnabled(true);
+	shader_t *bloomShader = game->GetScene()->GetPostProcessShader();
 
-	// Store a reference to the bloom shader so it can be adjusted whenever an effect requiring
-	// bloom occurs.
-	m_bloomShader = res_get_shader("effect-bloom");
+	if (bloomShader != nullptr) {
 
-	if (m_bloomShader != nullptr) {
+		shader_set_uniform_float(bloomShader, "BloomQuality", 2.5f);
+		shader_set_uniform_int(bloomShader, "BloomSamples", 5);
+	}
 
-		game->GetScene()->AddCameraEffect(m_bloomShader);
+	m_bloomShader = bloomShader;
 
-		shader_set_uniform_float(m_bloomShader, "BloomQuality", 2.5f);
+	if (m_bloomShader != nullptr) {
 		shader_set_uniform_float(m_bloomShader, "BloomFactor", 0.0f);
-		shader_set_uniform_int(m_bloomShader, "BloomSamples", 5);
 	}
 
 	// Shake the camera a bit.
 	game->GetScene()->ShakeCamera(0.3f, 0.4f);
 
 	// Play a hyperspace sound effect.
-	audio_play_sound(res_get_sound("Warp"), 0);
+	Utils::PlaySound("Warp", 0);
 }
 
 bool WarpEffect::Update(Game* game)
 {
 	UNUSED(game);
 
-	m_timeElapsed += get_time().delta_time;
+	m_timeElapsed += Utils::GetDeltaTime();
 
 	float t = m_timeElapsed / EFFECT_DURATION;
 	t = CLAMP01(t);
 
 	// Gradually scale the ship back to its right size.
 	float stretchFactor = t;
-	float scale = stretchFactor * 0.8f;
-	float scaleX = lerpf(5.0f, 0.8f, stretchFactor);
+	float scale = stretchFactor * Ship::SCALE;
+	float scaleX = lerpf(5.0f, Ship::SCALE, stretchFactor);
 
-	obj_set_local_scale(m_playerShip->GetSceneObject(), vec3(scaleX, scale, scale));
+	m_playerShip->SetStretch(scaleX, scale);
 
 	// Also gradually fade off the bloom effect.
-	shader_set_uniform_float(m_bloomShader, "BloomFactor", 1 - t);
+	if (m_bloomShader != nullptr) {
+		shader_set_uniform_float(m_bloomShader, "BloomFactor", 1 - t);
+	}
 
 	bool isFinished = (t >= 1);
 
 	if (isFinished) {
 
 		// Disable the bloom effect before the effect is destroyed.
-		game->GetScene()->RemoveCameraEffect(m_bloomShader);
+		game->GetScene()->SetBloomEnabled(false);
 		m_bloomShader = nullptr;
 	}
 
@@ -14,7 +14,7 @@ public:
 private:
 	Ship *m_playerShip = nullptr;
 	float m_timeElapsed = 0;
-	shader_t *m_bloomShader = nullptr; // Reference to bloom post processing shader
+	shader_t *m_bloomShader = nullptr; // Post processing shader the bloom is faded out in
 
 	static constexpr float EFFECT_DURATION = 0.25f;
 };